@@ -0,0 +1,374 @@
+/** ADT list: Singly linked list with a positional index.
+
+ Implementation file for the class IndexedLinkedList.
+ @file IndexedLinkedList.cpp */
+
+#include "IndexedLinkedList.hpp"  // Header file
+
+// constructor
+template<class T, class Alloc>
+IndexedLinkedList<T, Alloc>::IndexedLinkedList() : LinkedList<T, Alloc>(), top_level_(0), level_seed_(2463534242u)
+{
+   resetLanes();
+}  // end default constructor
+
+
+// copy constructor
+template<class T, class Alloc>
+IndexedLinkedList<T, Alloc>::IndexedLinkedList(const IndexedLinkedList<T, Alloc>& a_list)
+      : LinkedList<T, Alloc>(a_list), top_level_(0), level_seed_(a_list.level_seed_)
+{
+   // the chain is copied by LinkedList; only the lanes are built here
+   resetLanes();
+   buildLanes();
+}  // end copy constructor
+
+
+// destructor
+template<class T, class Alloc>
+IndexedLinkedList<T, Alloc>::~IndexedLinkedList()
+{
+   clear();
+}  // end destructor
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param new_entry to be inserted in list
+ @post new_entry is added at position in list (the node previously at that position is now at position+1)
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, class Alloc>
+bool IndexedLinkedList<T, Alloc>::insert(int position, const T& new_entry)
+{
+   bool able_to_insert = (position >= 0) && (position <= this->item_count_);
+   if (able_to_insert)
+   {
+      Lane* update[MAX_LEVEL];
+      int rank[MAX_LEVEL];
+      findPredecessors(position, update, rank);
+
+      // Attach new node to chain
+      Node<T>* new_node_ptr = this->node_allocator_.create(new_entry, nullptr);
+      if (position == 0)
+      {
+         new_node_ptr->setNext(this->head_ptr_);
+         this->head_ptr_ = new_node_ptr;
+      }
+      else
+      {
+         Node<T>* prev_ptr = walkChain(position - 1, update[0], rank[0]);
+         new_node_ptr->setNext(prev_ptr->getNext());
+         prev_ptr->setNext(new_node_ptr);
+      }  // end if
+
+      // Join the lowest level lanes; every entry that skips over position now skips one more node
+      int level = randomLevel();
+      int lane_count = (level > top_level_) ? level : top_level_;
+      Lane* below = nullptr;
+      for (int lane = 0; lane < lane_count; lane++)
+      {
+         Lane* prev_lane = update[lane];
+         if (lane < level)
+         {
+            Lane* entry = lane_pool_.create(Lane{new_node_ptr, prev_lane->next_ptr, below, 0});
+            if (prev_lane->next_ptr != nullptr)
+               entry->width = rank[lane] + prev_lane->width + 1 - position;
+            prev_lane->width = position - rank[lane];
+            prev_lane->next_ptr = entry;
+            below = entry;
+         }
+         else if (prev_lane->next_ptr != nullptr)
+         {
+            prev_lane->width++;
+         }  // end if
+      }  // end for
+      top_level_ = lane_count;
+
+      this->item_count_++;  // Increase count of entries
+   }  // end if
+
+   return able_to_insert;
+}  // end insert
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of deletion
+ @post node at position is deleted, if any. List order is retained
+ @return true if there is a node at position to be deleted, false otherwise */
+template<class T, class Alloc>
+bool IndexedLinkedList<T, Alloc>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < this->item_count_);
+   if (able_to_remove)
+   {
+      Lane* update[MAX_LEVEL];
+      int rank[MAX_LEVEL];
+      findPredecessors(position, update, rank);
+
+      Node<T>* cur_ptr = nullptr;
+      if (position == 0)
+      {
+         cur_ptr = this->head_ptr_;
+         this->head_ptr_ = this->head_ptr_->getNext();
+      }
+      else
+      {
+         Node<T>* prev_ptr = walkChain(position - 1, update[0], rank[0]);
+         cur_ptr = prev_ptr->getNext();
+         prev_ptr->setNext(cur_ptr->getNext());
+      }  // end if
+
+      // Leave every lane the node is in; entries that skip over it skip one less node
+      for (int lane = 0; lane < top_level_; lane++)
+      {
+         Lane* prev_lane = update[lane];
+         Lane* next_lane = prev_lane->next_ptr;
+         if (next_lane != nullptr && next_lane->node_ptr == cur_ptr)
+         {
+            prev_lane->width += next_lane->width - 1;
+            prev_lane->next_ptr = next_lane->next_ptr;
+            lane_pool_.destroy(next_lane);
+         }
+         else if (next_lane != nullptr)
+         {
+            prev_lane->width--;
+         }  // end if
+      }  // end for
+      while (top_level_ > 0 && heads_[top_level_ - 1].next_ptr == nullptr)
+         top_level_--;
+
+      // Return node to the allocator
+      this->node_allocator_.destroy(cur_ptr);
+      cur_ptr = nullptr;
+
+      this->item_count_--;  // Decrease count of entries
+   }  // end if
+
+   return able_to_remove;
+}  // end remove
+
+
+
+/**@post the list is empty and item_count_ == 0*/
+template<class T, class Alloc>
+void IndexedLinkedList<T, Alloc>::clear()
+{
+   // lane entries need no destructor: their slabs are taken back whole
+   lane_pool_.reset();
+   resetLanes();
+
+   LinkedList<T, Alloc>::clear();
+}  // end clear
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating the position of the data to be retrieved
+ @return data item found at position. If position is not a valid position < item_count_
+ throws  PrecondViolatedExcep */
+template<class T, class Alloc>
+T IndexedLinkedList<T, Alloc>::getEntry(int position) const
+{
+    // Enforce precondition
+    bool ableToGet = (position >= 0) && (position < this->item_count_);
+    if (ableToGet)
+    {
+        return getPointerTo(position)->getItem();
+    }
+    else
+    {
+        std::string message = "getEntry() called with an empty list or ";
+        message  = message + "invalid position.";
+        throw(PrecondViolatedExcep(message));
+    }  // end if
+}  // end getEntry
+
+
+//position follows classic indexing from 0 to item_count_-1
+//if position >= item_count it returns nullptr
+template<class T, class Alloc>
+Node<T>* IndexedLinkedList<T, Alloc>::getPointerTo(size_t position) const
+{
+   if (position >= static_cast<size_t>(this->item_count_))
+      return nullptr;
+
+   // Skip along each lane while the next entry is not past position
+   const Lane* entry = &heads_[top_level_ > 0 ? top_level_ - 1 : 0];
+   int entry_rank = -1;
+   int target = static_cast<int>(position);
+   for (int lane = top_level_ - 1; lane >= 0; lane--)
+   {
+      while (entry->next_ptr != nullptr && entry_rank + entry->width <= target)
+      {
+         entry_rank += entry->width;
+         entry = entry->next_ptr;
+      }  // end while
+      if (lane > 0)
+         entry = entry->down_ptr;
+   }  // end for
+
+   return walkChain(target, entry, entry_rank);
+}  // end getPointerTo
+
+
+
+/**
+ @pre position is an iterator of this list, not end()
+ @post the entry at position is deleted
+ @return an iterator at the entry that followed it */
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::iterator IndexedLinkedList<T, Alloc>::erase(typename LinkedList<T, Alloc>::iterator position)
+{
+   // the lanes are kept by remove; the iterator's position says where
+   remove(position.getPosition());
+   return this->iteratorAt(position.getPosition());
+}  // end erase
+
+
+
+/**
+ @pre position is an iterator of this list, not end()
+ @param new_entry to be inserted in list
+ @post new_entry is added right after the entry at position
+ @return an iterator at new_entry */
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::iterator IndexedLinkedList<T, Alloc>::insert_after(typename LinkedList<T, Alloc>::iterator position,
+                                                                           const T& new_entry)
+{
+   insert(position.getPosition() + 1, new_entry);
+   return this->iteratorAt(position.getPosition() + 1);
+}  // end insert_after
+
+
+
+
+/************* PRIVATE METHODS ************/
+
+
+// @post every lane is empty
+template<class T, class Alloc>
+void IndexedLinkedList<T, Alloc>::resetLanes()
+{
+   for (int lane = 0; lane < MAX_LEVEL; lane++)
+      heads_[lane] = Lane{nullptr, nullptr, (lane > 0) ? &heads_[lane - 1] : nullptr, 0};
+   top_level_ = 0;
+}  // end resetLanes
+
+
+// @post every node of the chain joins random lanes, in one O(n) pass
+template<class T, class Alloc>
+void IndexedLinkedList<T, Alloc>::buildLanes()
+{
+   // the last entry of each lane so far, and its position
+   Lane* tail[MAX_LEVEL];
+   int tail_rank[MAX_LEVEL];
+   for (int lane = 0; lane < MAX_LEVEL; lane++)
+   {
+      tail[lane] = &heads_[lane];
+      tail_rank[lane] = -1;
+   }  // end for
+
+   int position = 0;
+   for (Node<T>* cur_ptr = this->head_ptr_; cur_ptr != nullptr; cur_ptr = cur_ptr->getNext())
+   {
+      int level = randomLevel();
+      Lane* below = nullptr;
+      for (int lane = 0; lane < level; lane++)
+      {
+         Lane* entry = lane_pool_.create(Lane{cur_ptr, nullptr, below, 0});
+         tail[lane]->next_ptr = entry;
+         tail[lane]->width = position - tail_rank[lane];
+         tail[lane] = entry;
+         tail_rank[lane] = position;
+         below = entry;
+      }  // end for
+      if (level > top_level_)
+         top_level_ = level;
+      position++;
+   }  // end for
+}  // end buildLanes
+
+
+// @return the number of lanes a new node joins: k or more with probability 2^-k
+template<class T, class Alloc>
+int IndexedLinkedList<T, Alloc>::randomLevel()
+{
+   level_seed_ ^= level_seed_ << 13;
+   level_seed_ ^= level_seed_ >> 17;
+   level_seed_ ^= level_seed_ << 5;
+
+   // each low 1 bit is one more lane
+   unsigned bits = level_seed_;
+   int level = 0;
+   while (level < MAX_LEVEL && (bits & 1u))
+   {
+      level++;
+      bits >>= 1;
+   }  // end while
+   return level;
+}  // end randomLevel
+
+
+// @param position the position being looked up, inserted at or removed
+// @param update for every lane, the last entry before position
+// @param rank the position of each of those entries, -1 for a head
+template<class T, class Alloc>
+void IndexedLinkedList<T, Alloc>::findPredecessors(int position, Lane* update[], int rank[])
+{
+   // lanes above top_level_ are empty: their head is the predecessor
+   for (int lane = top_level_; lane < MAX_LEVEL; lane++)
+   {
+      update[lane] = &heads_[lane];
+      rank[lane] = -1;
+   }  // end for
+
+   Lane* entry = &heads_[top_level_ > 0 ? top_level_ - 1 : 0];
+   int entry_rank = -1;
+   for (int lane = top_level_ - 1; lane >= 0; lane--)
+   {
+      while (entry->next_ptr != nullptr && entry_rank + entry->width < position)
+      {
+         entry_rank += entry->width;
+         entry = entry->next_ptr;
+      }  // end while
+      update[lane] = entry;
+      rank[lane] = entry_rank;
+      if (lane > 0)
+         entry = entry->down_ptr;
+   }  // end for
+   if (top_level_ == 0)
+   {
+      update[0] = &heads_[0];
+      rank[0] = -1;
+   }  // end if
+}  // end findPredecessors
+
+
+// @param position a position, 0 <= position < item_count_
+// @param from an entry of lane 0 at or before position
+// @param from_rank the position of from, -1 for the head
+// @return a pointer to the node at position, walking the chain from from
+template<class T, class Alloc>
+Node<T>* IndexedLinkedList<T, Alloc>::walkChain(int position, const Lane* from, int from_rank) const
+{
+   Node<T>* cur_ptr = this->head_ptr_;
+   int cur_rank = 0;
+   if (from_rank >= 0)
+   {
+      cur_ptr = from->node_ptr;
+      cur_rank = from_rank;
+   }  // end if
+
+   // expected O(1) steps: a node is in lane 0 with probability 1/2
+   for (; cur_rank < position; cur_rank++)
+      cur_ptr = cur_ptr->getNext();
+   return cur_ptr;
+}  // end walkChain
+
+
+//  End of implementation file.
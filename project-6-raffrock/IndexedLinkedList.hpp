@@ -0,0 +1,114 @@
+/** ADT list: Singly linked list with a positional index.
+    A LinkedList whose positional operations run in expected O(log n)
+    instead of O(position). The nodes still form one chain from
+    getHeadNode(), so code that walks Node<T> pointers works unchanged.
+    @file IndexedLinkedList.hpp */
+
+#ifndef INDEXED_LINKED_LIST_
+#define INDEXED_LINKED_LIST_
+
+#include "LinkedList.hpp"
+
+/** The chain is the bottom level of a skip list. Above it, each node joins
+    a random number of express lanes (each lane half as likely as the one
+    below), and each lane entry stores how many chain steps it skips, so a
+    position is found by skipping along the highest lane that does not
+    overshoot it and dropping down one lane at a time.
+    Lane entries are kept by the list itself, in a SlabPool; Node<T> is not changed. */
+template<class T, class Alloc = NodePool<T>>
+class IndexedLinkedList : public LinkedList<T, Alloc>
+{
+
+public:
+   IndexedLinkedList(); // constructor
+   IndexedLinkedList(const IndexedLinkedList<T, Alloc>& a_list); // copy constructor
+   virtual ~IndexedLinkedList(); // destructor
+
+   // lanes point into one chain, so a list cannot be assigned over another
+   IndexedLinkedList<T, Alloc>& operator=(const IndexedLinkedList<T, Alloc>& a_list) = delete;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param new_entry to be inserted in list
+     @post new_entry is added at position in list (the node previously at that position is now at position+1).
+           Expected O(log n).
+     @return true if valid position (0 <= position <= item_count_) */
+   bool insert(int position, const T& new_entry) override;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of deletion
+     @post node at position is deleted, if any. List order is retained. Expected O(log n).
+     @return true if there is a node at position to be deleted, false otherwise */
+   bool remove(int position) override;
+
+   /**@post the list is empty and item_count_ == 0. O(1) with NodePool when T needs no destructor.*/
+   void clear() override;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating the position of the data to be retrieved
+     @return data item found at position, in expected O(log n). If position is not a valid
+            position < item_count_ throws PrecondViolatedExcep */
+   T getEntry(int position) const override;
+
+    //if position >= item_count_ returns nullptr; expected O(log n)
+   Node<T> *getPointerTo(size_t position) const override;
+
+    /**
+     @pre position is an iterator of this list, not end()
+     @post the entry at position is deleted. Expected O(log n), not O(1): the
+           lanes that skip over the node are found through its position
+     @return an iterator at the entry that followed it */
+   typename LinkedList<T, Alloc>::iterator erase(typename LinkedList<T, Alloc>::iterator position) override;
+
+    /**
+     @pre position is an iterator of this list, not end()
+     @param new_entry to be inserted in list
+     @post new_entry is added right after the entry at position. Expected O(log n), as erase
+     @return an iterator at new_entry */
+   typename LinkedList<T, Alloc>::iterator insert_after(typename LinkedList<T, Alloc>::iterator position,
+                                                        const T& new_entry) override;
+
+private:
+   // one more lane is enough for twice the nodes, so this covers ~16M
+   static const int MAX_LEVEL = 24;
+
+   struct Lane
+   {
+      Node<T>* node_ptr; // the chain node this entry stands for, nullptr in a head
+      Lane* next_ptr;    // the next entry of the same lane
+      Lane* down_ptr;    // the entry for the same node one lane lower, nullptr in lane 0
+      int width;         // chain steps from node_ptr to next_ptr->node_ptr
+   };
+
+   Lane heads_[MAX_LEVEL]; // one head per lane, standing before position 0
+   int top_level_;         // lanes [0, top_level_) have entries
+   unsigned level_seed_;   // xorshift state for randomLevel
+   SlabPool<Lane> lane_pool_; // every lane entry, so clear() drops them all at once
+
+   // @post every lane is empty
+   void resetLanes();
+
+   // @post every node of the chain joins random lanes, in one O(n) pass
+   void buildLanes();
+
+   // @return the number of lanes a new node joins: k or more with probability 2^-k
+   int randomLevel();
+
+   // @param position the position being looked up, inserted at or removed
+   // @param update for every lane, the last entry before position
+   // @param rank the position of each of those entries, -1 for a head
+   void findPredecessors(int position, Lane* update[], int rank[]);
+
+   // @param position a position, 0 <= position < item_count_
+   // @param from an entry of lane 0 at or before position
+   // @param from_rank the position of from, -1 for the head
+   // @return a pointer to the node at position, walking the chain from from
+   Node<T>* walkChain(int position, const Lane* from, int from_rank) const;
+
+}; // end IndexedLinkedList
+
+#include "IndexedLinkedList.cpp"
+#endif
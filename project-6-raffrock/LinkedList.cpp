@@ -15,15 +15,15 @@
 #include <cassert>
 
 // constructor
-template<class T>
-LinkedList<T>::LinkedList() : head_ptr_(nullptr), item_count_(0)
+template<class T, class Alloc>
+LinkedList<T, Alloc>::LinkedList() : head_ptr_(nullptr), item_count_(0)
 {
 }  // end default constructor
 
 
 // copy constructor
-template<class T>
-LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item_count_)
+template<class T, class Alloc>
+LinkedList<T, Alloc>::LinkedList(const LinkedList<T, Alloc>& a_list) : item_count_(a_list.item_count_)
 {
    Node<T>* orig_chain_pointer = a_list.head_ptr_;  // Points to nodes in original chain
 
@@ -32,19 +32,15 @@ LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item
    else
    {
       // Copy first node
-      head_ptr_ = new Node<T>();
-      head_ptr_->setItem(orig_chain_pointer->getItem());
+      head_ptr_ = node_allocator_.create(orig_chain_pointer->item(), nullptr);
 
       // Copy remaining nodes
       Node<T>* new_chain_ptr = head_ptr_;      // Points to last node in new chain
       orig_chain_pointer = orig_chain_pointer->getNext();     // Advance original-chain pointer
       while (orig_chain_pointer != nullptr)
       {
-         // Get next item from original chain
-         T next_item = orig_chain_pointer->getItem();
-
-         // Create a new node containing the next item
-         Node<T>* new_node_ptr = new Node<T>(next_item);
+         // Create a new node containing the next item from original chain
+         Node<T>* new_node_ptr = node_allocator_.create(orig_chain_pointer->item(), nullptr);
 
          // Link new node to end of new chain
          new_chain_ptr->setNext(new_node_ptr);
@@ -62,8 +58,8 @@ LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item
 
 
 // destructor
-template<class T>
-LinkedList<T>::~LinkedList()
+template<class T, class Alloc>
+LinkedList<T, Alloc>::~LinkedList()
 {
    clear();
 }  // end destructor
@@ -71,16 +67,16 @@ LinkedList<T>::~LinkedList()
 
 
 /**@return true if list is empty - item_count_ == 0 */
-template<class T>
-bool LinkedList<T>::isEmpty() const
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::isEmpty() const
 {
    return item_count_ == 0;
 }  // end isEmpty
 
 
 /**@return the number of items in the list - item_count_ */
-template<class T>
-int LinkedList<T>::getLength() const
+template<class T, class Alloc>
+int LinkedList<T, Alloc>::getLength() const
 {
    return item_count_;
 }  // end getLength
@@ -93,14 +89,14 @@ int LinkedList<T>::getLength() const
  @param new_entry to be inserted in list
  @post new_entry is added at position in list (the node previously at that position is now at position+1)
  @return true if valid position (0 <= position <= item_count_) */
-template<class T>
-bool LinkedList<T>::insert(int positions, const T& new_entry)
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::insert(int positions, const T& new_entry)
 {
    bool able_to_insert = (positions >= 0) && (positions <= item_count_ );
    if (able_to_insert)
    {
       // Create a new node containing the new entry
-      Node<T>* new_node_ptr = new Node<T>(new_entry);
+      Node<T>* new_node_ptr = node_allocator_.create(new_entry, nullptr);
 
       // Attach new node to chain
       if (positions == 0)
@@ -130,8 +126,8 @@ bool LinkedList<T>::insert(int positions, const T& new_entry)
  @param position indicating point of deletion
  @post node at position is deleted, if any. List order is retains
  @return true if there is a node at position to be deleted, false otherwise */
-template<class T>
-bool LinkedList<T>::remove(int position)
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::remove(int position)
 {
    bool able_to_remove = (position >= 0) && (position < item_count_);
    if (able_to_remove)
@@ -156,9 +152,8 @@ bool LinkedList<T>::remove(int position)
          prev_ptr->setNext(cur_ptr->getNext());
       }  // end if
 
-      // Return node to system
-      cur_ptr->setNext(nullptr);
-      delete cur_ptr;
+      // Return node to the allocator
+      node_allocator_.destroy(cur_ptr);
       cur_ptr = nullptr;
 
       item_count_--;  // Decrease count of entries
@@ -170,11 +165,13 @@ bool LinkedList<T>::remove(int position)
 
 
 /**@post the list is empty and item_count_ == 0*/
-template<class T>
-void LinkedList<T>::clear()
+template<class T, class Alloc>
+void LinkedList<T, Alloc>::clear()
 {
-   while (!isEmpty())
-      remove(0);
+   // the allocator takes the whole chain back at once
+   node_allocator_.destroyAll(head_ptr_);
+   head_ptr_ = nullptr;
+   item_count_ = 0;
 }  // end clear
 
 
@@ -184,8 +181,8 @@ void LinkedList<T>::clear()
  @param position indicating the position of the data to be retrieved
  @return data item found at position. If position is not a valid position < item_count_
  throws  PrecondViolatedExcep */
-template<class T>
-T LinkedList<T>::getEntry(int position) const
+template<class T, class Alloc>
+T LinkedList<T, Alloc>::getEntry(int position) const
 {
     // Enforce precondition
     bool ableToGet = (position >= 0) && (position < item_count_);
@@ -214,8 +211,8 @@ T LinkedList<T>::getEntry(int position) const
 // @param position the index of the desired node
 //       0 <= position < item_count_
 // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
-template<class T>
-Node<T>* LinkedList<T>::getNodeAt(int position) const
+template<class T, class Alloc>
+Node<T>* LinkedList<T, Alloc>::getNodeAt(int position) const
 {
     // Count from the beginning of the chain
     Node<T>* cur_ptr = head_ptr_;
@@ -227,12 +224,12 @@ Node<T>* LinkedList<T>::getNodeAt(int position) const
 
 //position follows classic indexing from 0 to item_count_-1
 //if position > item_count it returns nullptr
-template <class T>
-Node<T> *LinkedList<T>::getPointerTo(size_t position) const
+template<class T, class Alloc>
+Node<T> *LinkedList<T, Alloc>::getPointerTo(size_t position) const
 {
 
   Node<T> *find = nullptr;
-  if (position < item_count_)
+  if (position < static_cast<size_t>(item_count_))
   {
     find = head_ptr_;
     for (size_t i = 0; i < position; ++i)
@@ -248,12 +245,96 @@ Node<T> *LinkedList<T>::getPointerTo(size_t position) const
 
 
 //returns the head pointer
-template <class T>
-Node<T> *LinkedList<T>::getHeadNode() const
+template<class T, class Alloc>
+Node<T> *LinkedList<T, Alloc>::getHeadNode() const
 {
 
   return head_ptr_;
 } //end getHeadNode
 
 
+//@return an iterator at the first entry
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::begin()
+{
+  return iterator(nullptr, head_ptr_, 0);
+} //end begin
+
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::const_iterator LinkedList<T, Alloc>::begin() const
+{
+  return const_iterator(head_ptr_, 0);
+} //end begin
+
+
+//@return an iterator one past the last entry
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::end()
+{
+  return iterator(nullptr, nullptr, item_count_);
+} //end end
+
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::const_iterator LinkedList<T, Alloc>::end() const
+{
+  return const_iterator(nullptr, item_count_);
+} //end end
+
+
+
+/**
+ @pre position is an iterator of this list, not end()
+ @post the entry at position is deleted
+ @return an iterator at the entry that followed it */
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::erase(iterator position)
+{
+   Node<T>* cur_ptr = position.cur_ptr_;
+   Node<T>* next_ptr = cur_ptr->getNext();
+
+   // Disconnect the node by connecting the prior node with the one after
+   if (position.prev_ptr_ == nullptr)
+      head_ptr_ = next_ptr;
+   else
+      position.prev_ptr_->setNext(next_ptr);
+
+   // Return node to the allocator
+   node_allocator_.destroy(cur_ptr);
+   cur_ptr = nullptr;
+
+   item_count_--;  // Decrease count of entries
+   return iterator(position.prev_ptr_, next_ptr, position.position_);
+}  // end erase
+
+
+
+/**
+ @pre position is an iterator of this list, not end()
+ @param new_entry to be inserted in list
+ @post new_entry is added right after the entry at position
+ @return an iterator at new_entry */
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::insert_after(iterator position, const T& new_entry)
+{
+   Node<T>* prev_ptr = position.cur_ptr_;
+   Node<T>* new_node_ptr = node_allocator_.create(new_entry, prev_ptr->getNext());
+   prev_ptr->setNext(new_node_ptr);
+
+   item_count_++;  // Increase count of entries
+   return iterator(prev_ptr, new_node_ptr, position.position_ + 1);
+}  // end insert_after
+
+
+
+// @param position 0 <= position <= item_count_
+// @return an iterator at position, found through getPointerTo
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::iterator LinkedList<T, Alloc>::iteratorAt(int position) const
+{
+   Node<T>* prev_ptr = (position > 0) ? getPointerTo(position - 1) : nullptr;
+   Node<T>* cur_ptr = (prev_ptr != nullptr) ? prev_ptr->getNext() : head_ptr_;
+   return iterator(prev_ptr, cur_ptr, position);
+}  // end iteratorAt
+
+
 //  End of implementation file.
@@ -8,24 +8,124 @@
 
 /** ADT list: Singly linked list implementation.
     Listing 9-2.
+    The positional operations are virtual so that IndexedLinkedList can
+    replace them while being used through a LinkedList<T>.
+    Forward iterators walk the chain, so a range-for visits every entry
+    in O(n) where a getEntry(i) loop costs O(n^2).
+    Nodes are made and freed by Alloc (see NodePool.hpp). The default
+    NodePool reuses freed nodes, so a list that stays about the same size
+    does no heap allocation on insert/remove, and clear() takes the whole
+    chain back at once.
     @file LinkedList.h */
 
 #ifndef LINKED_LIST_
 #define LINKED_LIST_
 
 #include "Node.hpp"
+#include "NodePool.hpp"
 #include "PrecondViolatedExcep.hpp"
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 
-template<class T>
+template<class T, class Alloc = NodePool<T>>
 class LinkedList
 {
 
 public:
+   class const_iterator;
+
+   /** Forward iterator over the entries, front to back. Besides its node it
+       keeps the node before it and its position, so erase() can unlink the
+       node in O(1) and an IndexedLinkedList can find it in its lanes.
+       Inserting or removing entries invalidates every other iterator. */
+   class iterator
+   {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = T*;
+      using reference = T&;
+
+      iterator() : prev_ptr_(nullptr), cur_ptr_(nullptr), position_(0) {}
+
+      reference operator*() const { return cur_ptr_->item(); }
+      pointer operator->() const { return &cur_ptr_->item(); }
+
+      iterator& operator++()
+      {
+         prev_ptr_ = cur_ptr_;
+         cur_ptr_ = cur_ptr_->getNext();
+         position_++;
+         return *this;
+      }
+      iterator operator++(int) { iterator old = *this; ++*this; return old; }
+
+      bool operator==(const iterator& other) const { return cur_ptr_ == other.cur_ptr_; }
+      bool operator!=(const iterator& other) const { return cur_ptr_ != other.cur_ptr_; }
+
+      /**@return the position of the entry, 0 to item_count_ (item_count_ for end()) */
+      int getPosition() const { return position_; }
+
+   private:
+      friend class LinkedList<T, Alloc>;
+      friend class const_iterator;
+
+      iterator(Node<T>* prev_ptr, Node<T>* cur_ptr, int position)
+            : prev_ptr_(prev_ptr), cur_ptr_(cur_ptr), position_(position) {}
+
+      Node<T>* prev_ptr_; // the node before cur_ptr_, nullptr at the front
+      Node<T>* cur_ptr_;  // nullptr past the end
+      int position_;
+   }; // end iterator
+
+   /** As iterator, but the entries cannot be changed through it. */
+   class const_iterator
+   {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const T*;
+      using reference = const T&;
+
+      const_iterator() : cur_ptr_(nullptr), position_(0) {}
+      const_iterator(const iterator& it) : cur_ptr_(it.cur_ptr_), position_(it.position_) {}
+
+      reference operator*() const { return cur_ptr_->item(); }
+      pointer operator->() const { return &cur_ptr_->item(); }
+
+      const_iterator& operator++()
+      {
+         cur_ptr_ = cur_ptr_->getNext();
+         position_++;
+         return *this;
+      }
+      const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+
+      bool operator==(const const_iterator& other) const { return cur_ptr_ == other.cur_ptr_; }
+      bool operator!=(const const_iterator& other) const { return cur_ptr_ != other.cur_ptr_; }
+
+      /**@return the position of the entry, 0 to item_count_ (item_count_ for end()) */
+      int getPosition() const { return position_; }
+
+   private:
+      friend class LinkedList<T, Alloc>;
+
+      const_iterator(const Node<T>* cur_ptr, int position) : cur_ptr_(cur_ptr), position_(position) {}
+
+      const Node<T>* cur_ptr_; // nullptr past the end
+      int position_;
+   }; // end const_iterator
+
    LinkedList(); // constructor
-   LinkedList(const LinkedList<T>& a_list); // copy constructor
+   LinkedList(const LinkedList<T, Alloc>& a_list); // copy constructor
    virtual ~LinkedList(); // destructor
 
+   // the nodes belong to this list's allocator, so a list cannot be assigned over another
+   LinkedList<T, Alloc>& operator=(const LinkedList<T, Alloc>& a_list) = delete;
+
    /**@return true if list is empty - item_count_ == 0 */
    bool isEmpty() const;
 
@@ -39,7 +139,7 @@ public:
      @param new_entry to be inserted in list
      @post new_entry is added at position in list (the node previously at that position is now at position+1)
      @return true if valid position (0 <= position <= item_count_) */
-   bool insert(int position, const T& new_entry);
+   virtual bool insert(int position, const T& new_entry);
 
 
     /**
@@ -47,12 +147,12 @@ public:
      @param position indicating point of deletion
      @post node at position is deleted, if any. List order is retains
      @return true if there is a node at position to be deleted, false otherwise */
-   bool remove(int position);
+   virtual bool remove(int position);
 
 
 
-   /**@post the list is empty and item_count_ == 0*/
-   void clear();
+   /**@post the list is empty and item_count_ == 0. O(1) with NodePool when T needs no destructor*/
+   virtual void clear();
 
 
     /**
@@ -60,13 +160,34 @@ public:
      @param position indicating the position of the data to be retrieved
      @return data item found at position. If position is not a valid position < item_count_
             throws  PrecondViolatedExcep */
-   T getEntry(int position) const;
+   virtual T getEntry(int position) const;
 
         //if position > item_count_ returns nullptr
-    Node<T> *getPointerTo(size_t position) const;
+    virtual Node<T> *getPointerTo(size_t position) const;
 
     Node<T> *getHeadNode() const;
 
+   /**@return an iterator at the first entry, equal to end() if the list is empty*/
+   iterator begin();
+   const_iterator begin() const;
+
+   /**@return an iterator one past the last entry*/
+   iterator end();
+   const_iterator end() const;
+
+    /**
+     @pre position is an iterator of this list, not end()
+     @post the entry at position is deleted. O(1): the iterator already holds the node before it
+     @return an iterator at the entry that followed it */
+   virtual iterator erase(iterator position);
+
+    /**
+     @pre position is an iterator of this list, not end()
+     @param new_entry to be inserted in list
+     @post new_entry is added right after the entry at position. O(1)
+     @return an iterator at new_entry */
+   virtual iterator insert_after(iterator position, const T& new_entry);
+
 
 
 
@@ -75,6 +196,7 @@ protected:
     Node<T>* head_ptr_; // Pointer to first node in the chain;
     // (contains the first entry in the list)
     int item_count_;           // Current count of list items
+    Alloc node_allocator_;     // makes and frees the nodes of the chain
 
 
 
@@ -85,6 +207,10 @@ protected:
     // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
     Node<T>* getNodeAt(int position) const;
 
+    // @param position 0 <= position <= item_count_
+    // @return an iterator at position, found through getPointerTo
+    iterator iteratorAt(int position) const;
+
 
 
 
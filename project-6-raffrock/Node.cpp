@@ -60,3 +60,17 @@ Node<T>* Node<T>::getNext() const
 {
    return next_;
 } // end getNext
+
+ /**@return a reference to item_*/
+template<class T>
+T& Node<T>::item()
+{
+   return item_;
+} // end item
+
+ /**@return a reference to item_*/
+template<class T>
+const T& Node<T>::item() const
+{
+   return item_;
+} // end item
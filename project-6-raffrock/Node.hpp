@@ -29,6 +29,10 @@ public:
     
     /**@return next_*/
    Node<T>* getNext() const ;
+
+    /**@return a reference to item_, so it can be read or changed without a copy*/
+   T& item();
+   const T& item() const;
     
 private:
     T        item_; // A data item_
@@ -0,0 +1,212 @@
+/** Node allocators for LinkedList.
+
+ Implementation file for SlabPool, NodePool and HeapNodeAllocator.
+ @file NodePool.cpp */
+
+#include "NodePool.hpp"  // Header file
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// constructor
+template<class Block>
+SlabPool<Block>::SlabPool() : free_list_(nullptr), first_slab_(nullptr), cur_slab_(nullptr),
+                              next_unused_(nullptr), slab_end_(nullptr)
+{
+}  // end default constructor
+
+
+// destructor
+template<class Block>
+SlabPool<Block>::~SlabPool()
+{
+   while (first_slab_ != nullptr)
+   {
+      Slab* next_slab = first_slab_->next_slab;
+      ::operator delete(first_slab_);
+      first_slab_ = next_slab;
+   }  // end while
+}  // end destructor
+
+
+
+/**
+ @param args passed to a Block constructor
+ @return a pointer to a new Block made from args */
+template<class Block>
+template<class... Args>
+Block* SlabPool<Block>::create(Args&&... args)
+{
+   Slot* slot = takeSlot();
+   try
+   {
+      return ::new (static_cast<void*>(slot)) Block(std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      // the constructor threw: the slot is free again
+      slot->next_free = free_list_;
+      free_list_ = slot;
+      throw;
+   }  // end try
+}  // end create
+
+
+
+/**
+ @pre block_ptr came from create() of this pool and was not destroyed yet
+ @post *block_ptr is destroyed and its memory is kept for reuse */
+template<class Block>
+void SlabPool<Block>::destroy(Block* block_ptr)
+{
+   block_ptr->~Block();
+   Slot* slot = reinterpret_cast<Slot*>(block_ptr);
+   slot->next_free = free_list_;
+   free_list_ = slot;
+}  // end destroy
+
+
+
+/**
+ @pre every block handed out was destroyed, or its destructor does nothing
+ @post every slab is unused */
+template<class Block>
+void SlabPool<Block>::reset()
+{
+   free_list_ = nullptr;
+   cur_slab_ = first_slab_;
+   next_unused_ = (first_slab_ != nullptr) ? slotsOf(first_slab_) : nullptr;
+   slab_end_ = (first_slab_ != nullptr) ? next_unused_ + first_slab_->capacity : nullptr;
+}  // end reset
+
+
+
+/************* PRIVATE METHODS ************/
+
+
+// @return the first slot of slab_ptr
+template<class Block>
+typename SlabPool<Block>::Slot* SlabPool<Block>::slotsOf(Slab* slab_ptr)
+{
+   static_assert(alignof(Slot) <= alignof(Slab), "slots must be aligned right after a slab header");
+   return reinterpret_cast<Slot*>(slab_ptr + 1);
+}  // end slotsOf
+
+
+// @return a slot for one block: from the free list, the current slab, or a new slab
+template<class Block>
+typename SlabPool<Block>::Slot* SlabPool<Block>::takeSlot()
+{
+   Slot* slot = free_list_;
+   if (slot != nullptr)
+   {
+      free_list_ = slot->next_free;
+      return slot;
+   }  // end if
+
+   if (next_unused_ == slab_end_)
+      nextSlab();
+   return next_unused_++;
+}  // end takeSlot
+
+
+// @post next_unused_ points into the slab after cur_slab_, which is allocated if needed
+template<class Block>
+void SlabPool<Block>::nextSlab()
+{
+   Slab* next_slab = (cur_slab_ != nullptr) ? cur_slab_->next_slab : first_slab_;
+   if (next_slab == nullptr)
+   {
+      // each slab is twice the last, up to MAX_SLAB_SLOTS
+      std::size_t capacity = FIRST_SLAB_SLOTS;
+      if (cur_slab_ != nullptr)
+         capacity = (cur_slab_->capacity < MAX_SLAB_SLOTS) ? 2 * cur_slab_->capacity : MAX_SLAB_SLOTS;
+
+      void* memory = ::operator new(sizeof(Slab) + capacity * sizeof(Slot));
+      next_slab = ::new (memory) Slab{nullptr, capacity};
+      if (cur_slab_ != nullptr)
+         cur_slab_->next_slab = next_slab;
+      else
+         first_slab_ = next_slab;
+   }  // end if
+
+   cur_slab_ = next_slab;
+   next_unused_ = slotsOf(next_slab);
+   slab_end_ = next_unused_ + next_slab->capacity;
+}  // end nextSlab
+
+
+
+
+/************* NodePool ************/
+
+
+//@return a new node holding an_item and pointing to next_node_ptr
+template<class T>
+Node<T>* NodePool<T>::create(const T& an_item, Node<T>* next_node_ptr)
+{
+   return pool_.create(an_item, next_node_ptr);
+}  // end create
+
+
+//@post node_ptr is destroyed and its memory is kept for reuse
+template<class T>
+void NodePool<T>::destroy(Node<T>* node_ptr)
+{
+   pool_.destroy(node_ptr);
+}  // end destroy
+
+
+//@post every node of the chain at head_ptr is destroyed, and the slabs are ready for reuse
+template<class T>
+void NodePool<T>::destroyAll(Node<T>* head_ptr)
+{
+   // items that need no destructor are dropped with their slabs, without visiting them
+   if constexpr (!std::is_trivially_destructible<T>::value)
+   {
+      while (head_ptr != nullptr)
+      {
+         Node<T>* next_ptr = head_ptr->getNext();
+         head_ptr->~Node<T>();
+         head_ptr = next_ptr;
+      }  // end while
+   }  // end if
+   pool_.reset();
+}  // end destroyAll
+
+
+
+
+/************* HeapNodeAllocator ************/
+
+
+//@return a new node holding an_item and pointing to next_node_ptr
+template<class T>
+Node<T>* HeapNodeAllocator<T>::create(const T& an_item, Node<T>* next_node_ptr)
+{
+   return new Node<T>(an_item, next_node_ptr);
+}  // end create
+
+
+//@post node_ptr is deleted
+template<class T>
+void HeapNodeAllocator<T>::destroy(Node<T>* node_ptr)
+{
+   delete node_ptr;
+}  // end destroy
+
+
+//@post every node of the chain at head_ptr is deleted
+template<class T>
+void HeapNodeAllocator<T>::destroyAll(Node<T>* head_ptr)
+{
+   while (head_ptr != nullptr)
+   {
+      Node<T>* next_ptr = head_ptr->getNext();
+      delete head_ptr;
+      head_ptr = next_ptr;
+   }  // end while
+}  // end destroyAll
+
+
+//  End of implementation file.
@@ -0,0 +1,126 @@
+/** Node allocators for LinkedList.
+    A node allocator makes and frees the nodes of one list. It provides
+       Node<T>* create(const T& an_item, Node<T>* next_node_ptr);
+       void destroy(Node<T>* node_ptr);
+       void destroyAll(Node<T>* head_ptr); // every node of the chain at head_ptr
+    NodePool, the default, carves nodes out of slabs and keeps freed nodes
+    for reuse; HeapNodeAllocator does one new/delete per node.
+    @file NodePool.hpp */
+
+#ifndef NODE_POOL_
+#define NODE_POOL_
+
+#include "Node.hpp"
+#include <cstddef>
+
+/** Fixed-size blocks carved out of slabs. A destroyed block goes on a free
+    list and is handed out again before any new slab memory, so once a
+    pool has grown to a list's peak size, create/destroy do no heap traffic.
+    Slabs are kept until the pool is destroyed; reset() makes all of them
+    unused again in O(1). */
+template<class Block>
+class SlabPool
+{
+
+public:
+   SlabPool(); // constructor
+   ~SlabPool(); // destructor
+
+   // blocks belong to one pool, which frees them all at once
+   SlabPool(const SlabPool<Block>&) = delete;
+   SlabPool<Block>& operator=(const SlabPool<Block>&) = delete;
+
+    /**
+     @param args passed to a Block constructor
+     @return a pointer to a new Block made from args */
+   template<class... Args>
+   Block* create(Args&&... args);
+
+    /**
+     @pre block_ptr came from create() of this pool and was not destroyed yet
+     @post *block_ptr is destroyed and its memory is kept for reuse */
+   void destroy(Block* block_ptr);
+
+    /**
+     @pre every block handed out was destroyed, or its destructor does nothing
+     @post every slab is unused. O(1): blocks are not visited */
+   void reset();
+
+private:
+   // a free block's memory holds the link to the next free block
+   union Slot
+   {
+      Slot* next_free;
+      alignas(Block) unsigned char storage[sizeof(Block)];
+   };
+
+   // header at the front of each slab; its slots follow it
+   struct alignas(alignof(std::max_align_t)) Slab
+   {
+      Slab* next_slab;
+      std::size_t capacity; // slots in this slab
+   };
+
+   static const std::size_t FIRST_SLAB_SLOTS = 16;
+   static const std::size_t MAX_SLAB_SLOTS = 4096;
+
+   Slot* free_list_;   // destroyed blocks, most recent first
+   Slab* first_slab_;
+   Slab* cur_slab_;    // the slab next_unused_ points into; later slabs are unused
+   Slot* next_unused_; // slots from here to slab_end_ were never handed out since the last reset
+   Slot* slab_end_;
+
+   // @return the first slot of slab_ptr
+   static Slot* slotsOf(Slab* slab_ptr);
+
+   // @return a slot for one block: from the free list, the current slab, or a new slab
+   Slot* takeSlot();
+
+   // @post next_unused_ points into the slab after cur_slab_, which is allocated if needed
+   void nextSlab();
+
+}; // end SlabPool
+
+
+/** The default node allocator: nodes come from a SlabPool. */
+template<class T>
+class NodePool
+{
+
+public:
+    /**@return a new node holding an_item and pointing to next_node_ptr*/
+   Node<T>* create(const T& an_item, Node<T>* next_node_ptr);
+
+    /**@post node_ptr is destroyed and its memory is kept for reuse*/
+   void destroy(Node<T>* node_ptr);
+
+    /**
+     @post every node of the chain at head_ptr is destroyed, and the pool's
+           slabs are ready for reuse. O(1) when T's destructor does nothing */
+   void destroyAll(Node<T>* head_ptr);
+
+private:
+   SlabPool<Node<T>> pool_;
+
+}; // end NodePool
+
+
+/** A node allocator that does one new and one delete per node. */
+template<class T>
+class HeapNodeAllocator
+{
+
+public:
+    /**@return a new node holding an_item and pointing to next_node_ptr*/
+   Node<T>* create(const T& an_item, Node<T>* next_node_ptr);
+
+    /**@post node_ptr is deleted*/
+   void destroy(Node<T>* node_ptr);
+
+    /**@post every node of the chain at head_ptr is deleted. O(n)*/
+   void destroyAll(Node<T>* head_ptr);
+
+}; // end HeapNodeAllocator
+
+#include "NodePool.cpp"
+#endif
@@ -21,9 +21,11 @@ bool StationManager::addStation(KitchenStation* station) {
 
 // Removes a station from the station manager by name
 bool StationManager::removeStation(const std::string& station_name) {
-    for (int i = 0; i < item_count_; ++i) {
-        if (getEntry(i)->getName() == station_name) {
-            return remove(i);
+    // one pass: the iterator already holds the node before the match
+    for (iterator it = begin(); it != end(); ++it) {
+        if ((*it)->getName() == station_name) {
+            erase(it);
+            return true;
         }
     }
     return false;
@@ -31,12 +33,10 @@ bool StationManager::removeStation(const std::string& station_name) {
 
 // Finds a station in the station manager by name
 KitchenStation* StationManager::findStation(const std::string& station_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == station_name) {
-            return searchptr->getItem();
+    for (KitchenStation* station : *this) {
+        if (station->getName() == station_name) {
+            return station;
         }
-        searchptr = searchptr->getNext();
     }
     return nullptr;
 }
@@ -130,12 +130,10 @@ bool StationManager::replenishIngredientAtStation(const std::string& station_nam
 
 // Checks if any station in the station manager can complete an order for a specific dish
 bool StationManager::canCompleteOrder(const std::string& dish_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->canCompleteOrder(dish_name)) {
+    for (KitchenStation* station : *this) {
+        if (station->canCompleteOrder(dish_name)) {
             return true;
         }
-        searchptr = searchptr->getNext();
     }
     return false;
 }
@@ -232,13 +230,10 @@ bool StationManager::prepareNextDish() {
         return false; // dish cannot be completed at any station
     }
 
-    std::string station_name; // holds name for prepareDishAtStation
-
     // find station that can prepare dish
-    for (size_t i = 0; i < getLength(); i++) {
-        station_name = getEntry(i)->getName();
-        if (findStation(station_name)->canCompleteOrder(next_dish_name)) {
-            findStation(station_name)->prepareDish(next_dish_name);
+    for (KitchenStation* station : *this) {
+        if (station->canCompleteOrder(next_dish_name)) {
+            station->prepareDish(next_dish_name);
             dish_queue_.pop();
             return true;
         }
@@ -298,11 +293,16 @@ stock, or the ingredient or station is not found, returns false.
 otherwise.
 */
 bool StationManager::replenishStationIngredientFromBackup(std::string station_name, std::string ingredient_name, int quantity) {
+    KitchenStation* station = findStation(station_name);
     // if station not present
-    if (findStation(station_name) == nullptr) {
+    if (station == nullptr) {
         return false;
     }
+    return replenishFromBackup(station, ingredient_name, quantity);
+}
 
+// replenishStationIngredientFromBackup for a station already found
+bool StationManager::replenishFromBackup(KitchenStation* station, const std::string& ingredient_name, int quantity) {
     for (size_t i = 0; i < backup_ingredients_.size(); i++) {
         if (backup_ingredients_[i].name == ingredient_name) { 
 
@@ -319,8 +319,9 @@ bool StationManager::replenishStationIngredientFromBackup(std::string station_na
                 return false; // not enough to replenish
             }
 
-            // attempt to add to station
-            return replenishIngredientAtStation(station_name, ingredient_at_quantity);
+            // add to station
+            station->replenishStationIngredients(ingredient_at_quantity);
+            return true;
         }
     }
     return false; // ing not found
@@ -418,18 +419,18 @@ void StationManager::processAllDishes() {
         std::cout << "PREPARING DISH: " << dish_name << std::endl;
 
         // going through stations to find one that can prepare dish
-        for (size_t i = 0; i < getLength(); i++) {
+        for (KitchenStation* station : *this) {
 
-            station_name = getEntry(i)->getName();
+            station_name = station->getName();
             std::cout << station_name << " attempting to prepare " << dish_name << "..." << std::endl;
             bool dish_found = false;
             
-            for (Dish* d : getEntry(i)->getDishes()) {
+            for (Dish* d : station->getDishes()) {
                 // station has dish
                 if (d->getName() == dish_name) {
                     dish_found = true;
                     // dish prepared
-                    if (prepareDishAtStation(station_name,dish_name)) {
+                    if (station->canCompleteOrder(dish_name) && station->prepareDish(dish_name)) {
                         std::cout << station_name << ": Successfully prepared " << dish_name << "." << std::endl;
                         prepared = true;
                         break;
@@ -440,28 +441,28 @@ void StationManager::processAllDishes() {
                         bool replenished = false; 
                         for (Ingredient d_ing : dish->getIngredients()) {
                             bool found = false;
-                            for (Ingredient s_ing : findStation(station_name)->getIngredientsStock()) 
+                            for (Ingredient s_ing : station->getIngredientsStock()) 
                             {
                                 if (d_ing.name == s_ing.name) 
                                 {
                                     found = true;
                                     int difference = d_ing.required_quantity - s_ing.quantity;
                                     // if ing found in low qautity, attempt to add needed quantity
-                                    if (difference > 0 && replenishStationIngredientFromBackup(station_name, d_ing.name, difference)) 
+                                    if (difference > 0 && replenishFromBackup(station, d_ing.name, difference)) 
                                     {
                                         replenished = true;
                                     }
                                 }
                             }
                             // if ing not found, attemot to add correct amount
-                            if (!found && replenishStationIngredientFromBackup(station_name, d_ing.name, d_ing.required_quantity)) {
+                            if (!found && replenishFromBackup(station, d_ing.name, d_ing.required_quantity)) {
                                 replenished = true;
                             } 
                         }
                         // if any ing is replenished
                         if (replenished) {
                                 std::cout << station_name << ": Ingredients replenished." << std::endl;
-                            if (prepareDishAtStation(station_name,dish_name)) {
+                            if (station->canCompleteOrder(dish_name) && station->prepareDish(dish_name)) {
                                 // if dish can now be prepared
                                 std::cout << station_name << ": Successfully prepared " << dish_name << "." << std::endl;
                                 prepared = true;
@@ -8,7 +8,7 @@
 #ifndef STATIONMANAGER_HPP
 #define STATIONMANAGER_HPP
 
-#include "LinkedList.hpp"
+#include "IndexedLinkedList.hpp"
 #include "KitchenStation.hpp"
 #include "Dish.hpp"
 #include <string>
@@ -16,7 +16,7 @@
 #include <queue>
 // #include <vector>
 
-class StationManager : public LinkedList<KitchenStation*> {
+class StationManager : public IndexedLinkedList<KitchenStation*> {
 public:
     /**
      * Default Constructor
@@ -251,6 +251,10 @@ private:
     // helper function to get index of a station by name
     int getStationIndex(const std::string& station_name) const;
 
+    // replenishStationIngredientFromBackup for a station already found, so
+    // processAllDishes does not search the list again for every ingredient
+    bool replenishFromBackup(KitchenStation* station, const std::string& ingredient_name, int quantity);
+
     std::queue<Dish*> dish_queue_;
     std::vector<Ingredient> backup_ingredients_;
 
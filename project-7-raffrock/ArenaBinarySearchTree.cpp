@@ -0,0 +1,270 @@
+/** @file ArenaBinarySearchTree.cpp */
+
+#include "ArenaBinarySearchTree.hpp"
+#include <algorithm>
+#include <vector>
+
+
+/*CONSTRUCTORS*/
+
+template <class T>
+ArenaBinarySearchTree<T>::ArenaBinarySearchTree() : root_(NULL_INDEX)
+{
+} // end default constructor
+
+template <class T>
+ArenaBinarySearchTree<T>::ArenaBinarySearchTree(const T &root_item) : root_(NULL_INDEX)
+{
+  root_ = nodes_.allocate(root_item);
+} // end constructor
+
+
+
+/*PUBLIC METHODS*/
+
+template <class T>
+bool ArenaBinarySearchTree<T>::isEmpty() const
+{
+  return root_ == NULL_INDEX;
+} // end isEmpty
+
+template <class T>
+int ArenaBinarySearchTree<T>::getHeight() const
+{
+  return heightOf(root_);
+} // end getHeight
+
+template <class T>
+int ArenaBinarySearchTree<T>::getNumberOfNodes() const
+{
+  return static_cast<int>(nodes_.size());
+} // end getNumberOfNodes
+
+template <class T>
+void ArenaBinarySearchTree<T>::add(const T &new_entry)
+{
+  std::uint32_t new_node = nodes_.allocate(new_entry);
+  root_ = placeNode(root_, new_node);
+} // end add
+
+template <class T>
+bool ArenaBinarySearchTree<T>::remove(const T &entry)
+{
+  return removeKey(entry);
+} // end remove
+
+template <class T>
+bool ArenaBinarySearchTree<T>::contains(const T &entry) const
+{
+  return findNode(entry) != NULL_INDEX;
+} // end contains
+
+template <class T>
+template <class K>
+const T *ArenaBinarySearchTree<T>::find(const K &key) const
+{
+  std::uint32_t node = findNode(key);
+  return node == NULL_INDEX ? nullptr : &nodes_[node].item;
+} // end find
+
+template <class T>
+template <class K>
+bool ArenaBinarySearchTree<T>::removeKey(const K &key)
+{
+  bool is_successful = false;
+  root_ = removeValue(root_, key, is_successful);
+  return is_successful;
+} // end removeKey
+
+template <class T>
+void ArenaBinarySearchTree<T>::clear()
+{
+  nodes_.clear();
+  root_ = NULL_INDEX;
+} // end clear
+
+template <class T>
+void ArenaBinarySearchTree<T>::reserve(std::size_t count)
+{
+  nodes_.reserve(count);
+} // end reserve
+
+template <class T>
+void ArenaBinarySearchTree<T>::displayPreorder() const
+{
+  std::vector<std::uint32_t> node_stack;
+  if (root_ != NULL_INDEX)
+    node_stack.push_back(root_);
+  while (!node_stack.empty())
+  {
+    std::uint32_t node = node_stack.back();
+    node_stack.pop_back();
+    std::cout << nodes_[node].item << " ";
+    if (nodes_[node].right != NULL_INDEX)
+      node_stack.push_back(nodes_[node].right);
+    if (nodes_[node].left != NULL_INDEX)
+      node_stack.push_back(nodes_[node].left);
+  }
+  std::cout << std::endl;
+} // end displayPreorder
+
+
+
+/*PRIVATE METHODS*/
+
+template <class T>
+std::uint32_t ArenaBinarySearchTree<T>::placeNode(std::uint32_t subtree, std::uint32_t new_node)
+{
+  if (subtree == NULL_INDEX)
+    return new_node;
+
+  // nodes_ does not grow during placement, so slot references stay valid
+  if (nodes_[subtree].item > nodes_[new_node].item)
+  {
+    std::uint32_t left = placeNode(nodes_[subtree].left, new_node);
+    nodes_[subtree].left = left;
+  }
+  else
+  {
+    std::uint32_t right = placeNode(nodes_[subtree].right, new_node);
+    nodes_[subtree].right = right;
+  }
+  return rebalance(subtree);
+} // end placeNode
+
+template <class T>
+template <class K>
+std::uint32_t ArenaBinarySearchTree<T>::findNode(const K &target) const
+{
+  std::uint32_t node = root_;
+  while (node != NULL_INDEX)
+  {
+    const T &item = nodes_[node].item;
+    if (item == target)
+      return node;
+    node = (item > target) ? nodes_[node].left : nodes_[node].right;
+  }
+  return NULL_INDEX;
+} // end findNode
+
+template <class T>
+template <class K>
+std::uint32_t ArenaBinarySearchTree<T>::removeValue(std::uint32_t subtree, const K &target, bool &success)
+{
+  if (subtree == NULL_INDEX)
+  {
+    success = false;
+    return subtree;
+  }
+  if (nodes_[subtree].item == target)
+  {
+    success = true;
+    return removeNode(subtree);
+  }
+  if (nodes_[subtree].item > target)
+  {
+    std::uint32_t left = removeValue(nodes_[subtree].left, target, success);
+    nodes_[subtree].left = left;
+  }
+  else
+  {
+    std::uint32_t right = removeValue(nodes_[subtree].right, target, success);
+    nodes_[subtree].right = right;
+  }
+  return rebalance(subtree);
+} // end removeValue
+
+template <class T>
+std::uint32_t ArenaBinarySearchTree<T>::removeNode(std::uint32_t node)
+{
+  std::uint32_t left = nodes_[node].left;
+  std::uint32_t right = nodes_[node].right;
+  std::uint32_t replacement;
+
+  if (left == NULL_INDEX)
+    replacement = right; // leaf or right child only
+  else if (right == NULL_INDEX)
+    replacement = left; // left child only
+  else
+  {
+    // Two children: relink the inorder successor in place of node,
+    // so no item has to be copied
+    std::uint32_t successor;
+    std::uint32_t new_right = removeLeftmostNode(right, successor);
+    nodes_[successor].left = left;
+    nodes_[successor].right = new_right;
+    replacement = rebalance(successor);
+  }
+  nodes_.release(node);
+  return replacement;
+} // end removeNode
+
+template <class T>
+std::uint32_t ArenaBinarySearchTree<T>::removeLeftmostNode(std::uint32_t node, std::uint32_t &leftmost)
+{
+  if (nodes_[node].left == NULL_INDEX)
+  {
+    leftmost = node;
+    return nodes_[node].right;
+  }
+  std::uint32_t left = removeLeftmostNode(nodes_[node].left, leftmost);
+  nodes_[node].left = left;
+  return rebalance(node);
+} // end removeLeftmostNode
+
+template <class T>
+int ArenaBinarySearchTree<T>::heightOf(std::uint32_t node) const
+{
+  return node == NULL_INDEX ? 0 : nodes_[node].height;
+} // end heightOf
+
+template <class T>
+void ArenaBinarySearchTree<T>::updateHeight(std::uint32_t node)
+{
+  nodes_[node].height = 1 + std::max(heightOf(nodes_[node].left), heightOf(nodes_[node].right));
+} // end updateHeight
+
+template <class T>
+std::uint32_t ArenaBinarySearchTree<T>::rotateLeft(std::uint32_t node)
+{
+  std::uint32_t pivot = nodes_[node].right;
+  nodes_[node].right = nodes_[pivot].left;
+  nodes_[pivot].left = node;
+  updateHeight(node);
+  updateHeight(pivot);
+  return pivot;
+} // end rotateLeft
+
+template <class T>
+std::uint32_t ArenaBinarySearchTree<T>::rotateRight(std::uint32_t node)
+{
+  std::uint32_t pivot = nodes_[node].left;
+  nodes_[node].left = nodes_[pivot].right;
+  nodes_[pivot].right = node;
+  updateHeight(node);
+  updateHeight(pivot);
+  return pivot;
+} // end rotateRight
+
+template <class T>
+std::uint32_t ArenaBinarySearchTree<T>::rebalance(std::uint32_t node)
+{
+  updateHeight(node);
+  int balance = heightOf(nodes_[node].left) - heightOf(nodes_[node].right);
+
+  if (balance > 1)
+  {
+    std::uint32_t left = nodes_[node].left;
+    if (heightOf(nodes_[left].left) < heightOf(nodes_[left].right))
+      nodes_[node].left = rotateLeft(left);
+    return rotateRight(node);
+  }
+  else if (balance < -1)
+  {
+    std::uint32_t right = nodes_[node].right;
+    if (heightOf(nodes_[right].right) < heightOf(nodes_[right].left))
+      nodes_[node].right = rotateRight(right);
+    return rotateLeft(node);
+  }
+  return node;
+} // end rebalance
@@ -0,0 +1,104 @@
+/** Binary search tree whose nodes live in a NodeArena.
+ Same interface as BinarySearchTree, balanced like BinarySearchTree<T, AvlBalance>,
+ but children are 32-bit indices into one contiguous pool instead of shared_ptrs,
+ so there is no per-node allocation and no reference counting while walking.
+ @file ArenaBinarySearchTree.hpp */
+
+#ifndef ARENA_BINARY_SEARCH_TREE_
+#define ARENA_BINARY_SEARCH_TREE_
+
+#include "NodeArena.hpp"
+#include <cstdint>
+#include <iostream>
+
+template <class T>
+class ArenaBinarySearchTree
+{
+public:
+  /*Constructors*/
+  ArenaBinarySearchTree();                   //default constructor
+  ArenaBinarySearchTree(const T &root_item); //parameterized constructor
+
+  /** @return true if the tree is emtpy, false otherwise **/
+  bool isEmpty() const;
+
+  /** @return the height of the tree as the number of nodes on the longest path from root to leaf**/
+  int getHeight() const;
+
+  /** @return the number of nodes in the tree**/
+  int getNumberOfNodes() const;
+
+  /** @param new_entry a new entry to be added to the tree
+      @post new_entry is added retaining the BST and AVL properties**/
+  void add(const T &new_entry);
+
+  /** @param entry to be removed from the tree
+      @post entry is removed retaining the BST and AVL properties
+      @return true if entry was found and removed, false otherwise**/
+  bool remove(const T &entry);
+
+  /** @param entry to be found in the tree
+      @return true if entry is found, false otherwise**/
+  bool contains(const T &entry) const;
+
+  /** Heterogeneous lookup, see BinarySearchTree::find.
+      @param key the key to be found
+      @return a pointer to the item equal to key, nullptr if not found.
+              The pointer is invalidated by the next add.**/
+  template <class K>
+  const T *find(const K &key) const;
+
+  /** @param key the key of the entry to be removed
+      @return true if an entry was removed, false otherwise**/
+  template <class K>
+  bool removeKey(const K &key);
+
+  /** @post the tree is empty, all node storage is released in one step**/
+  void clear();
+
+  /** @post room for count nodes is allocated up front**/
+  void reserve(std::size_t count);
+
+  /**Display preorder traversal through the tree**/
+  void displayPreorder() const;
+
+private:
+  static constexpr std::uint32_t NULL_INDEX = NodeArena<T>::NULL_INDEX;
+
+  NodeArena<T> nodes_;
+  std::uint32_t root_;
+
+  /** called by add
+      @return the index of the root of the subtree in which the node was placed**/
+  std::uint32_t placeNode(std::uint32_t subtree, std::uint32_t new_node);
+
+  /** called by remove and removeKey
+      @return the index of the root of the subtree after target was removed**/
+  template <class K>
+  std::uint32_t removeValue(std::uint32_t subtree, const K &target, bool &success);
+
+  /** called by removeValue
+      @post the node is unlinked and its slot released
+      @return the index of the node that takes its place**/
+  std::uint32_t removeNode(std::uint32_t node);
+
+  /** called by removeNode
+      @param leftmost set to the index of the unlinked leftmost node
+      @return the index of the root of the subtree after the leftmost node was unlinked**/
+  std::uint32_t removeLeftmostNode(std::uint32_t node, std::uint32_t &leftmost);
+
+  /** called by find and contains
+      @return the index of the node equal to target, NULL_INDEX if not found**/
+  template <class K>
+  std::uint32_t findNode(const K &target) const;
+
+  // AVL helpers, same rules as AvlBalance
+  int heightOf(std::uint32_t node) const;
+  void updateHeight(std::uint32_t node);
+  std::uint32_t rotateLeft(std::uint32_t node);
+  std::uint32_t rotateRight(std::uint32_t node);
+  std::uint32_t rebalance(std::uint32_t node);
+};
+
+#include "ArenaBinarySearchTree.cpp"
+#endif
@@ -0,0 +1,723 @@
+/** @file BTree.cpp */
+
+#include "BTree.hpp"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+
+/*CONSTRUCTORS*/
+
+template <class T, int MinDegree>
+BTree<T, MinDegree>::BTree() : root_ptr_(nullptr), item_count_(0), height_(0)
+{
+} // end default constructor
+
+template <class T, int MinDegree>
+BTree<T, MinDegree>::BTree(const T &root_item) : BTree()
+{
+  add(root_item);
+} // end constructor
+
+template <class T, int MinDegree>
+BTree<T, MinDegree>::BTree(const BTree &another_tree)
+    : root_ptr_(copyNode(another_tree.root_ptr_.get())), item_count_(another_tree.item_count_), height_(another_tree.height_)
+{
+} // end copy constructor
+
+template <class T, int MinDegree>
+BTree<T, MinDegree>::BTree(BTree &&another_tree) noexcept
+    : root_ptr_(std::move(another_tree.root_ptr_)), item_count_(another_tree.item_count_), height_(another_tree.height_)
+{
+  another_tree.item_count_ = 0;
+  another_tree.height_ = 0;
+} // end move constructor
+
+template <class T, int MinDegree>
+BTree<T, MinDegree> &BTree<T, MinDegree>::operator=(const BTree &another_tree)
+{
+  if (this != &another_tree)
+  {
+    // copy first, so a throwing copy leaves this tree as it was
+    std::unique_ptr<Node> new_root = copyNode(another_tree.root_ptr_.get());
+    root_ptr_ = std::move(new_root);
+    item_count_ = another_tree.item_count_;
+    height_ = another_tree.height_;
+  }
+  return *this;
+} // end copy assignment
+
+template <class T, int MinDegree>
+BTree<T, MinDegree> &BTree<T, MinDegree>::operator=(BTree &&another_tree) noexcept
+{
+  if (this != &another_tree)
+  {
+    root_ptr_ = std::move(another_tree.root_ptr_);
+    item_count_ = another_tree.item_count_;
+    height_ = another_tree.height_;
+    another_tree.item_count_ = 0;
+    another_tree.height_ = 0;
+  }
+  return *this;
+} // end move assignment
+
+
+
+/*PUBLIC METHODS*/
+
+template <class T, int MinDegree>
+const typename BTree<T, MinDegree>::Node *BTree<T, MinDegree>::getRoot() const
+{
+  return root_ptr_.get();
+} // end getRoot
+
+template <class T, int MinDegree>
+bool BTree<T, MinDegree>::isEmpty() const
+{
+  return item_count_ == 0;
+} // end isEmpty
+
+template <class T, int MinDegree>
+int BTree<T, MinDegree>::getHeight() const
+{
+  return height_;
+} // end getHeight
+
+template <class T, int MinDegree>
+int BTree<T, MinDegree>::getNumberOfNodes() const
+{
+  return item_count_;
+} // end getNumberOfNodes
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::add(const T &new_entry)
+{
+  add(T(new_entry));
+} // end add
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::add(T &&new_entry)
+{
+  if (root_ptr_ == nullptr)
+  {
+    root_ptr_ = std::make_unique<Node>();
+    height_ = 1;
+  }
+  if (root_ptr_->count == MAX_ITEMS)
+  {
+    // The only way the tree grows taller: a new root above the full one
+    std::unique_ptr<Node> new_root = std::make_unique<Node>();
+    new_root->leaf = false;
+    new_root->children[0] = std::move(root_ptr_);
+    root_ptr_ = std::move(new_root);
+    splitChild(root_ptr_.get(), 0);
+    height_++;
+  }
+
+  // Every node entered below has room, since full children are split first
+  Key new_key = keyOf(new_entry);
+  Node *node = root_ptr_.get();
+  while (!node->leaf)
+  {
+    // equal items go right, like BinarySearchTree::add
+    int index = upperIndex(node, new_entry, new_key);
+    if (node->children[index]->count == MAX_ITEMS)
+    {
+      splitChild(node, index);
+      if (!(node->items[index] > new_entry))
+        index++;
+    }
+    node = node->children[index].get();
+  }
+
+  int index = upperIndex(node, new_entry, new_key);
+  for (int i = node->count; i > index; i--)
+    moveItem(node, i, node, i - 1);
+  putItem(node, index, std::move(new_entry));
+  node->count++;
+  item_count_++;
+} // end add
+
+template <class T, int MinDegree>
+bool BTree<T, MinDegree>::remove(const T &entry)
+{
+  return removeValue(entry);
+} // end remove
+
+template <class T, int MinDegree>
+bool BTree<T, MinDegree>::contains(const T &entry) const
+{
+  return find(entry) != nullptr;
+} // end contains
+
+template <class T, int MinDegree>
+template <class K>
+const T *BTree<T, MinDegree>::find(const K &key) const
+{
+  Key key_of_key = keyOf(key);
+  const Node *node = root_ptr_.get();
+  while (node != nullptr)
+  {
+    int index = lowerIndex(node, key, key_of_key);
+    // the item is only read when its key ties
+    if (index < node->count && node->keys[index] == key_of_key && node->items[index] == key)
+      return &node->items[index]; // Found
+    node = node->leaf ? nullptr : node->children[index].get();
+  }
+  return nullptr; // Not found
+} // end find
+
+template <class T, int MinDegree>
+template <class K>
+T *BTree<T, MinDegree>::find(const K &key)
+{
+  return const_cast<T *>(static_cast<const BTree *>(this)->find(key));
+} // end find
+
+template <class T, int MinDegree>
+template <class K>
+bool BTree<T, MinDegree>::removeKey(const K &key)
+{
+  return removeValue(key);
+} // end removeKey
+
+template <class T, int MinDegree>
+typename BTree<T, MinDegree>::const_iterator BTree<T, MinDegree>::begin() const
+{
+  const_iterator first(root_ptr_.get());
+  if (root_ptr_ != nullptr)
+  {
+    first.descendLeft(root_ptr_.get());
+    first.skipFinished();
+  }
+  return first;
+} // end begin
+
+template <class T, int MinDegree>
+typename BTree<T, MinDegree>::const_iterator BTree<T, MinDegree>::end() const
+{
+  return const_iterator(root_ptr_.get());
+} // end end
+
+template <class T, int MinDegree>
+template <class K>
+typename BTree<T, MinDegree>::const_iterator BTree<T, MinDegree>::lower_bound(const K &key) const
+{
+  return seek(key, false);
+} // end lower_bound
+
+template <class T, int MinDegree>
+template <class K>
+typename BTree<T, MinDegree>::const_iterator BTree<T, MinDegree>::upper_bound(const K &key) const
+{
+  return seek(key, true);
+} // end upper_bound
+
+template <class T, int MinDegree>
+template <class K>
+std::pair<typename BTree<T, MinDegree>::const_iterator, typename BTree<T, MinDegree>::const_iterator>
+BTree<T, MinDegree>::equal_range(const K &key) const
+{
+  return {seek(key, false), seek(key, true)};
+} // end equal_range
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::clear()
+{
+  // unique_ptr teardown recurses once per level, and there are only log n levels
+  root_ptr_.reset();
+  item_count_ = 0;
+  height_ = 0;
+} // end clear
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::displayPreorder() const
+{
+  std::vector<const Node *> node_stack;
+  if (root_ptr_ != nullptr)
+    node_stack.push_back(root_ptr_.get());
+  while (!node_stack.empty())
+  {
+    const Node *node = node_stack.back();
+    node_stack.pop_back();
+    for (int i = 0; i < node->count; i++)
+      std::cout << node->items[i] << " ";
+    if (!node->leaf)
+      for (int i = node->count; i >= 0; i--)
+        node_stack.push_back(node->children[i].get());
+  }
+} // end displayPreorder
+
+
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::rebuildBalanced()
+{
+  std::vector<T> items;
+  items.reserve(item_count_);
+  if (root_ptr_ != nullptr)
+    moveItems(root_ptr_.get(), items);
+  buildFromSorted(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+} // end rebuildBalanced
+
+template <class T, int MinDegree>
+template <class ForwardIt>
+void BTree<T, MinDegree>::buildFromSorted(ForwardIt first, ForwardIt last)
+{
+  clear();
+  long long count = std::distance(first, last);
+  if (count == 0)
+    return;
+  int height = 1;
+  while (capacity(height) < count)
+    height++;
+  root_ptr_ = buildNode(first, count, height, true);
+  item_count_ = static_cast<int>(count);
+  height_ = height;
+} // end buildFromSorted
+
+
+
+/*ITERATOR*/
+
+template <class T, int MinDegree>
+typename BTree<T, MinDegree>::const_iterator &BTree<T, MinDegree>::const_iterator::operator++()
+{
+  Step &current = path_.back();
+  if (current.node->leaf)
+  {
+    current.index++;
+    skipFinished();
+  }
+  else
+  {
+    // the next item is the leftmost of the child right of the current one
+    current.index++;
+    descendLeft(current.node->children[current.index].get());
+  }
+  return *this;
+} // end operator++
+
+template <class T, int MinDegree>
+typename BTree<T, MinDegree>::const_iterator &BTree<T, MinDegree>::const_iterator::operator--()
+{
+  if (path_.empty())
+  {
+    // From end(): the largest item ends the rightmost path; an empty tree has none
+    if (root_ == nullptr)
+      return *this;
+    descendRight(root_);
+    path_.back().index--;
+    return *this;
+  }
+  Step &current = path_.back();
+  if (!current.node->leaf)
+  {
+    // the previous item is the rightmost of the child left of the current one
+    descendRight(current.node->children[current.index].get());
+    path_.back().index--;
+    return *this;
+  }
+  if (current.index > 0)
+  {
+    current.index--;
+    return *this;
+  }
+  // climb to the first node the path entered from a child other than its first
+  path_.pop_back();
+  while (!path_.empty() && path_.back().index == 0)
+    path_.pop_back();
+  if (!path_.empty())
+    path_.back().index--;
+  return *this;
+} // end operator--
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::const_iterator::descendLeft(const Node *node)
+{
+  while (true)
+  {
+    path_.push_back({node, 0});
+    if (node->leaf)
+      return;
+    node = node->children[0].get();
+  }
+} // end descendLeft
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::const_iterator::descendRight(const Node *node)
+{
+  // every step is one past its last item; the caller steps the leaf back onto its item
+  while (true)
+  {
+    path_.push_back({node, node->count});
+    if (node->leaf)
+      return;
+    node = node->children[node->count].get();
+  }
+} // end descendRight
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::const_iterator::skipFinished()
+{
+  // a step entered from children[index] continues at items[index], if there is one
+  while (!path_.empty() && path_.back().index >= path_.back().node->count)
+    path_.pop_back();
+} // end skipFinished
+
+
+
+/*PRIVATE METHODS*/
+
+template <class T, int MinDegree>
+template <class K>
+int BTree<T, MinDegree>::lowerIndex(const Node *node, const K &key, const Key &key_of_key)
+{
+  // A straight scan over the keys, which sit in a few contiguous cache lines;
+  // items are compared only among the keys that tie with key's
+  int index = 0;
+  while (index < node->count && node->keys[index] < key_of_key)
+    index++;
+  while (index < node->count && node->keys[index] == key_of_key && node->items[index] < key)
+    index++;
+  return index;
+} // end lowerIndex
+
+template <class T, int MinDegree>
+template <class K>
+int BTree<T, MinDegree>::upperIndex(const Node *node, const K &key, const Key &key_of_key)
+{
+  int index = 0;
+  while (index < node->count && node->keys[index] < key_of_key)
+    index++;
+  while (index < node->count && node->keys[index] == key_of_key && !(node->items[index] > key))
+    index++;
+  return index;
+} // end upperIndex
+
+template <class T, int MinDegree>
+template <class Item>
+void BTree<T, MinDegree>::putItem(Node *node, int index, Item &&item)
+{
+  // the key first, item may be moved from below
+  node->keys[index] = keyOf(item);
+  node->items[index] = std::forward<Item>(item);
+} // end putItem
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::moveItem(Node *to, int to_index, Node *from, int from_index)
+{
+  to->keys[to_index] = from->keys[from_index];
+  to->items[to_index] = std::move(from->items[from_index]);
+} // end moveItem
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::splitChild(Node *parent, int index)
+{
+  Node *full = parent->children[index].get();
+  std::unique_ptr<Node> right = std::make_unique<Node>();
+  right->leaf = full->leaf;
+
+  // The upper MinDegree - 1 items (and their children) move to the new node
+  right->count = MinDegree - 1;
+  for (int i = 0; i < MinDegree - 1; i++)
+    moveItem(right.get(), i, full, i + MinDegree);
+  if (!full->leaf)
+    for (int i = 0; i < MinDegree; i++)
+      right->children[i] = std::move(full->children[i + MinDegree]);
+  full->count = MinDegree - 1;
+
+  // Open a gap in parent for the median and the new child
+  for (int i = parent->count; i > index; i--)
+  {
+    moveItem(parent, i, parent, i - 1);
+    parent->children[i + 1] = std::move(parent->children[i]);
+  }
+  moveItem(parent, index, full, MinDegree - 1);
+  parent->children[index + 1] = std::move(right);
+  parent->count++;
+} // end splitChild
+
+template <class T, int MinDegree>
+template <class K>
+bool BTree<T, MinDegree>::removeValue(const K &target)
+{
+  if (root_ptr_ == nullptr)
+    return false;
+
+  bool success = false;
+  Key target_key = keyOf(target);
+  Node *node = root_ptr_.get();
+  while (true)
+  {
+    int index = lowerIndex(node, target, target_key);
+    if (index < node->count && node->keys[index] == target_key && node->items[index] == target)
+    {
+      if (node->leaf)
+      {
+        eraseFromLeaf(node, index);
+        success = true;
+        break;
+      }
+      if (node->children[index]->count >= MinDegree)
+      {
+        // Replace with the inorder predecessor
+        putItem(node, index, takeMax(node->children[index].get()));
+        success = true;
+        break;
+      }
+      if (node->children[index + 1]->count >= MinDegree)
+      {
+        // Replace with the inorder successor
+        putItem(node, index, takeMin(node->children[index + 1].get()));
+        success = true;
+        break;
+      }
+      // Both neighbours are minimal: merge them around target and carry on below
+      mergeChildren(node, index);
+      node = node->children[index].get();
+      continue;
+    }
+    if (node->leaf)
+      break; // Not found
+    // Make sure the child can lose an item before walking into it
+    index = fillChild(node, index);
+    node = node->children[index].get();
+  }
+
+  if (success)
+    item_count_--;
+  // A merge may have emptied the root: its only child takes over
+  if (root_ptr_->count == 0)
+  {
+    if (root_ptr_->leaf)
+    {
+      root_ptr_.reset();
+      height_ = 0;
+    }
+    else
+    {
+      std::unique_ptr<Node> old_root = std::move(root_ptr_);
+      root_ptr_ = std::move(old_root->children[0]);
+      height_--;
+    }
+  }
+  return success;
+} // end removeValue
+
+template <class T, int MinDegree>
+int BTree<T, MinDegree>::fillChild(Node *parent, int index)
+{
+  Node *child = parent->children[index].get();
+  if (child->count >= MinDegree)
+    return index;
+
+  if (index > 0 && parent->children[index - 1]->count >= MinDegree)
+  {
+    // Borrow through the parent from the left sibling
+    Node *left = parent->children[index - 1].get();
+    for (int i = child->count; i > 0; i--)
+      moveItem(child, i, child, i - 1);
+    if (!child->leaf)
+      for (int i = child->count + 1; i > 0; i--)
+        child->children[i] = std::move(child->children[i - 1]);
+    moveItem(child, 0, parent, index - 1);
+    if (!child->leaf)
+      child->children[0] = std::move(left->children[left->count]);
+    child->count++;
+    moveItem(parent, index - 1, left, left->count - 1);
+    left->items[left->count - 1] = T();
+    left->count--;
+    return index;
+  }
+
+  if (index < parent->count && parent->children[index + 1]->count >= MinDegree)
+  {
+    // Borrow through the parent from the right sibling
+    Node *right = parent->children[index + 1].get();
+    moveItem(child, child->count, parent, index);
+    if (!child->leaf)
+      child->children[child->count + 1] = std::move(right->children[0]);
+    child->count++;
+    moveItem(parent, index, right, 0);
+    for (int i = 0; i < right->count - 1; i++)
+      moveItem(right, i, right, i + 1);
+    if (!right->leaf)
+      for (int i = 0; i < right->count; i++)
+        right->children[i] = std::move(right->children[i + 1]);
+    right->items[right->count - 1] = T();
+    right->count--;
+    return index;
+  }
+
+  // Both siblings are minimal too: merge with one of them
+  if (index < parent->count)
+  {
+    mergeChildren(parent, index);
+    return index;
+  }
+  mergeChildren(parent, index - 1);
+  return index - 1;
+} // end fillChild
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::mergeChildren(Node *parent, int index)
+{
+  Node *left = parent->children[index].get();
+  Node *right = parent->children[index + 1].get();
+
+  moveItem(left, left->count, parent, index);
+  for (int i = 0; i < right->count; i++)
+    moveItem(left, left->count + 1 + i, right, i);
+  if (!left->leaf)
+    for (int i = 0; i <= right->count; i++)
+      left->children[left->count + 1 + i] = std::move(right->children[i]);
+  left->count += right->count + 1;
+
+  // Close the gap in parent; moving over children[index + 1] frees the right node
+  for (int i = index; i < parent->count - 1; i++)
+  {
+    moveItem(parent, i, parent, i + 1);
+    parent->children[i + 1] = std::move(parent->children[i + 2]);
+  }
+  parent->items[parent->count - 1] = T();
+  parent->children[parent->count].reset();
+  parent->count--;
+} // end mergeChildren
+
+template <class T, int MinDegree>
+T BTree<T, MinDegree>::takeMax(Node *node)
+{
+  while (!node->leaf)
+  {
+    int index = fillChild(node, node->count);
+    node = node->children[index].get();
+  }
+  T item = std::move(node->items[node->count - 1]);
+  eraseFromLeaf(node, node->count - 1);
+  return item;
+} // end takeMax
+
+template <class T, int MinDegree>
+T BTree<T, MinDegree>::takeMin(Node *node)
+{
+  while (!node->leaf)
+  {
+    int index = fillChild(node, 0);
+    node = node->children[index].get();
+  }
+  T item = std::move(node->items[0]);
+  eraseFromLeaf(node, 0);
+  return item;
+} // end takeMin
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::eraseFromLeaf(Node *node, int index)
+{
+  for (int i = index; i < node->count - 1; i++)
+    moveItem(node, i, node, i + 1);
+  // release whatever the vacated slot still owns
+  node->items[node->count - 1] = T();
+  node->count--;
+} // end eraseFromLeaf
+
+template <class T, int MinDegree>
+std::unique_ptr<typename BTree<T, MinDegree>::Node> BTree<T, MinDegree>::copyNode(const Node *node)
+{
+  if (node == nullptr)
+    return nullptr;
+  // recursion goes one level deep per node level, and there are only log n levels
+  std::unique_ptr<Node> copy = std::make_unique<Node>();
+  copy->count = node->count;
+  copy->leaf = node->leaf;
+  for (int i = 0; i < node->count; i++)
+  {
+    copy->keys[i] = node->keys[i];
+    copy->items[i] = node->items[i];
+  }
+  if (!node->leaf)
+    for (int i = 0; i <= node->count; i++)
+      copy->children[i] = copyNode(node->children[i].get());
+  return copy;
+} // end copyNode
+
+template <class T, int MinDegree>
+void BTree<T, MinDegree>::moveItems(Node *node, std::vector<T> &items)
+{
+  for (int i = 0; i < node->count; i++)
+  {
+    if (!node->leaf)
+      moveItems(node->children[i].get(), items);
+    items.push_back(std::move(node->items[i]));
+  }
+  if (!node->leaf)
+    moveItems(node->children[node->count].get(), items);
+} // end moveItems
+
+template <class T, int MinDegree>
+long long BTree<T, MinDegree>::capacity(int height)
+{
+  long long full = 1;
+  for (int level = 0; level < height; level++)
+  {
+    full *= 2 * MinDegree;
+    if (full > std::numeric_limits<int>::max())
+      return full;
+  }
+  return full - 1;
+} // end capacity
+
+template <class T, int MinDegree>
+template <class ForwardIt>
+std::unique_ptr<typename BTree<T, MinDegree>::Node> BTree<T, MinDegree>::buildNode(ForwardIt &first, long long count, int height, bool is_root)
+{
+  std::unique_ptr<Node> node = std::make_unique<Node>();
+  if (height == 1)
+  {
+    for (long long i = 0; i < count; i++, ++first)
+      putItem(node.get(), static_cast<int>(i), *first);
+    node->count = static_cast<int>(count);
+    return node;
+  }
+
+  // the fewest children that hold count items between them, but at least
+  // MinDegree below the root; each child then gets at least its minimum
+  long long child_capacity = capacity(height - 1);
+  long long children = (count + 1 + child_capacity) / (child_capacity + 1);
+  children = std::max<long long>(children, is_root ? 2 : MinDegree);
+  long long child_items = count - (children - 1);
+
+  node->leaf = false;
+  node->count = static_cast<int>(children - 1);
+  for (long long i = 0; i < children; i++)
+  {
+    long long share = child_items / children + (i < child_items % children ? 1 : 0);
+    node->children[i] = buildNode(first, share, height - 1, false);
+    if (i + 1 < children)
+    {
+      putItem(node.get(), static_cast<int>(i), *first);
+      ++first;
+    }
+  }
+  return node;
+} // end buildNode
+
+template <class T, int MinDegree>
+template <class K>
+typename BTree<T, MinDegree>::const_iterator BTree<T, MinDegree>::seek(const K &key, bool past_equal) const
+{
+  const_iterator position(root_ptr_.get());
+  Key key_of_key = keyOf(key);
+  const Node *node = root_ptr_.get();
+  while (node != nullptr)
+  {
+    int index = past_equal ? upperIndex(node, key, key_of_key) : lowerIndex(node, key, key_of_key);
+    // in a leaf the index is the answer, above it the child the walk goes into
+    position.path_.push_back({node, index});
+    node = node->leaf ? nullptr : node->children[index].get();
+  }
+  position.skipFinished();
+  return position;
+} // end seek
@@ -0,0 +1,368 @@
+/** B-tree with the same interface as BinarySearchTree.
+ Every node holds up to 2 * MinDegree - 1 items, and the tree is log base
+ MinDegree of n levels tall instead of log base 2.
+ A node keeps a small key per item (see BTreeKey) in one contiguous array and
+ its items out of line, so the search within a node scans a few cache lines of
+ keys and reads an item only when its key ties with the one searched for. The
+ default MinDegree sizes the key array to about four cache lines.
+ Items are kept in the nodes themselves (not a B+-tree), so each item is stored once.
+ @file BTree.hpp */
+
+#ifndef B_TREE_
+#define B_TREE_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** The key a BTree node keeps for each item. Keys must be ordered like their items,
+ and like the lookup keys passed to find and the bounds, but they may tie where the
+ items differ: ties are settled by comparing the items.
+ The default keeps no key at all, so every search compares the items; specialize it
+ (with a type and an of() for the item and each lookup key type) for items that are
+ large or slow to compare, as RecipeBook.hpp does for Recipe. **/
+template <class T>
+struct BTreeKey
+{
+  /** always ties **/
+  struct type
+  {
+    bool operator<(const type &) const { return false; }
+    bool operator==(const type &) const { return true; }
+  };
+
+  template <class K>
+  static type of(const K &) { return type(); }
+};
+
+/** A BTreeKey for items ordered by a string: its first 16 bytes, compared as two
+ big-endian integers. Shorter strings are padded with zero bytes, which sort
+ first, so the order of the prefixes never contradicts the order of the strings. **/
+struct BTreeStringPrefix
+{
+  std::uint64_t high;
+  std::uint64_t low;
+
+  bool operator<(const BTreeStringPrefix &other) const
+  {
+    return high < other.high || (high == other.high && low < other.low);
+  }
+  bool operator==(const BTreeStringPrefix &other) const
+  {
+    return high == other.high && low == other.low;
+  }
+
+  static BTreeStringPrefix of(std::string_view text)
+  {
+    BTreeStringPrefix prefix{0, 0};
+    for (std::size_t i = 0; i < 16; i++)
+    {
+      std::uint64_t byte = i < text.size() ? static_cast<unsigned char>(text[i]) : 0;
+      std::uint64_t &half = i < 8 ? prefix.high : prefix.low;
+      half = half << 8 | byte;
+    }
+    return prefix;
+  }
+};
+
+/** @return the MinDegree whose 2 * MinDegree - 1 keys fill about four 64-byte cache lines.
+    Without a key the items are searched instead, sized the same way; large items
+    get at least 8, since the walk is then bound by the number of levels. **/
+template <class T>
+constexpr int defaultMinDegree()
+{
+  constexpr std::size_t searched = std::is_empty<typename BTreeKey<T>::type>::value ? sizeof(T) : sizeof(typename BTreeKey<T>::type);
+  return (4 * 64 / searched + 1) / 2 < 8 ? 8 : static_cast<int>((4 * 64 / searched + 1) / 2);
+}
+
+template <class T, int MinDegree = defaultMinDegree<T>()>
+class BTree
+{
+  static_assert(MinDegree >= 2, "a B-tree node needs a minimum degree of at least 2");
+
+public:
+  static constexpr int MAX_ITEMS = 2 * MinDegree - 1;
+
+  using Key = typename BTreeKey<T>::type;
+
+  /** A node, handed out read-only by getRoot. **/
+  struct Node
+  {
+    int count = 0;    // items in use, items[0..count) are sorted
+    bool leaf = true;
+    Key keys[MAX_ITEMS]; // keys[i] is the key of items[i]; all a search reads until keys tie
+    std::unique_ptr<Node> children[MAX_ITEMS + 1]; // children[i] holds the items between items[i-1] and items[i]
+    std::unique_ptr<T[]> items = std::make_unique<T[]>(MAX_ITEMS); // out of line, off the search path
+  };
+
+  /** Bidirectional inorder iterator, like BinarySearchTree::const_iterator.
+      Holds the path from the root to its item, so ++ and -- are amortized O(1);
+      within a leaf they only move an index. Any add or remove invalidates it. **/
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() : root_(nullptr) {}
+
+    reference operator*() const { return *item(); }
+    pointer operator->() const { return item(); }
+
+    /** @post moves to the next item, or to end() after the largest item **/
+    const_iterator &operator++();
+    const_iterator operator++(int)
+    {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    /** @post moves to the previous item; from end() moves to the largest item **/
+    const_iterator &operator--();
+    const_iterator operator--(int)
+    {
+      const_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &other) const { return item() == other.item(); }
+    bool operator!=(const const_iterator &other) const { return item() != other.item(); }
+
+  private:
+    friend class BTree;
+
+    /** a node on the path, and the index of its current item or of the child the path went into **/
+    struct Step
+    {
+      const Node *node;
+      int index;
+    };
+
+    const Node *root_;
+    // root first, the current item's node last; empty at end()
+    std::vector<Step> path_;
+
+    explicit const_iterator(const Node *root) : root_(root) {}
+
+    const T *item() const { return path_.empty() ? nullptr : &path_.back().node->items[path_.back().index]; }
+
+    /** @post pushes node and the first child of every node below it, down to a leaf **/
+    void descendLeft(const Node *node);
+
+    /** @post pushes node and the last child of every node below it, down to a leaf **/
+    void descendRight(const Node *node);
+
+    /** @post pops the nodes whose items are all behind the path, so the last step is at an item or the path is empty **/
+    void skipFinished();
+  };
+
+  using iterator = const_iterator;
+
+  /*Constructors*/
+  BTree();                            //default constructor
+  BTree(const T &root_item);          //parameterized constructor
+  BTree(const BTree &another_tree);   //copy constructor
+  BTree(BTree &&another_tree) noexcept; //move constructor, leaves another_tree empty
+
+  /** @post this tree holds a deep copy of another_tree's nodes; its old nodes are released
+      @return *this **/
+  BTree &operator=(const BTree &another_tree);
+
+  /** @post this tree takes over another_tree's nodes in O(1) and another_tree is left empty
+      @return *this **/
+  BTree &operator=(BTree &&another_tree) noexcept;
+
+  /** @return the root node, read-only, nullptr if the tree is empty **/
+  const Node *getRoot() const;
+
+  /** @return true if the tree is emtpy, false otherwise **/
+  bool isEmpty() const;
+
+  /** @return the height of the tree as the number of nodes on any path from root to leaf;
+      every leaf is at the same depth**/
+  int getHeight() const;
+
+  /** @return the number of items in the tree, to match BinarySearchTree::getNumberOfNodes**/
+  int getNumberOfNodes() const;
+
+  /** @param new_entry a new entry to be added to the tree
+      @post new_entry is added in order; full nodes met on the way down are split,
+            so the insert takes a single pass**/
+  void add(const T &new_entry);
+
+  /** @param new_entry a new entry to be moved into the tree
+      @post as add(const T&), without copying the entry **/
+  void add(T &&new_entry);
+
+  /** @param entry to be removed from the tree
+      @post entry is removed, every node but the root keeps at least MinDegree - 1 items
+      @return true if entry was found and removed, false otherwise**/
+  bool remove(const T &entry);
+
+  /** @param entry to be found in the tree
+      @return true if entry is found, false otherwise**/
+  bool contains(const T &entry) const;
+
+  /** Heterogeneous lookup, see BinarySearchTree::find.
+      @param key the key to be found
+      @return a pointer to the item equal to key, nullptr if not found.
+              The pointer is invalidated by the next add or remove.**/
+  template <class K>
+  const T *find(const K &key) const;
+
+  /** @return as find(key) const, but the item may be changed in ways that keep its order **/
+  template <class K>
+  T *find(const K &key);
+
+  /** @param key the key of the entry to be removed
+      @return true if an entry was removed, false otherwise**/
+  template <class K>
+  bool removeKey(const K &key);
+
+  /** @return an iterator to the smallest item, end() if the tree is empty **/
+  const_iterator begin() const;
+
+  /** @return the past-the-end iterator **/
+  const_iterator end() const;
+
+  /** Heterogeneous like find. Each runs one O(height) descent.
+      @param key the key to be searched for
+      @return an iterator to the first item not less than key, end() if none**/
+  template <class K>
+  const_iterator lower_bound(const K &key) const;
+
+  /** @param key the key to be searched for
+      @return an iterator to the first item greater than key, end() if none**/
+  template <class K>
+  const_iterator upper_bound(const K &key) const;
+
+  /** @param key the key to be searched for
+      @return the range [lower_bound(key), upper_bound(key)), empty if key is absent**/
+  template <class K>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+
+  /** @post the tree is empty and every node is released**/
+  void clear();
+
+  /** A B-tree never leans, so this only repacks it, for BinarySearchTree's interface.
+      @post the items are moved into as few nodes and levels as buildFromSorted builds. O(n)**/
+  void rebuildBalanced();
+
+  /** @param first, last a range of items sorted ascending, without duplicates;
+             pass move iterators to move the items into the tree
+      @post the tree holds exactly those items, built bottom-up in the fewest levels
+            that hold them, with the items spread evenly over each level. Runs in
+            O(n), items are not compared.**/
+  template <class ForwardIt>
+  void buildFromSorted(ForwardIt first, ForwardIt last);
+
+  /**Display preorder traversal through the tree, node by node**/
+  void displayPreorder() const;
+
+private:
+  std::unique_ptr<Node> root_ptr_;
+  int item_count_;
+  int height_;
+
+  /** @return the node key of key, an item or a lookup key **/
+  template <class K>
+  static Key keyOf(const K &key) { return BTreeKey<T>::of(key); }
+
+  /** called by find, removeValue and seek
+      @param key_of_key keyOf(key), computed once per walk
+      @return the index of the first item in node that is not less than key, node->count if none**/
+  template <class K>
+  static int lowerIndex(const Node *node, const K &key, const Key &key_of_key);
+
+  /** called by add and seek
+      @return the index of the first item in node that is greater than key, node->count if none**/
+  template <class K>
+  static int upperIndex(const Node *node, const K &key, const Key &key_of_key);
+
+  /** @post items[index] of node holds item, and keys[index] its key **/
+  template <class Item>
+  static void putItem(Node *node, int index, Item &&item);
+
+  /** @post items[to_index] of to and its key are moved from items[from_index] of from **/
+  static void moveItem(Node *to, int to_index, Node *from, int from_index);
+
+  /** called by add
+      @param parent a node that is not full
+      @param index the index of a full child of parent
+      @post the child is split around its median, which moves up into parent**/
+  static void splitChild(Node *parent, int index);
+
+  /** called by remove and removeKey
+      @post the item equal to target is removed in one pass down the tree
+      @return true if an item was removed**/
+  template <class K>
+  bool removeValue(const K &target);
+
+  /** called by removeValue, takeMax and takeMin
+      @param parent a node with at least MinDegree items, or the root
+      @param index the index of the child the walk is about to descend into
+      @post that child holds at least MinDegree items, borrowed from a sibling
+            or by merging with one
+      @return the index of the child to descend into, which moves left after a merge with the left sibling**/
+  static int fillChild(Node *parent, int index);
+
+  /** called by fillChild and removeValue
+      @post children[index], items[index] and children[index + 1] of parent are merged into children[index]**/
+  static void mergeChildren(Node *parent, int index);
+
+  /** called by removeValue
+      @param node the root of a subtree with at least MinDegree items
+      @return the largest item of the subtree, removed from it**/
+  static T takeMax(Node *node);
+
+  /** called by removeValue
+      @param node the root of a subtree with at least MinDegree items
+      @return the smallest item of the subtree, removed from it**/
+  static T takeMin(Node *node);
+
+  /** @post items[index] of a leaf is removed and the rest shifted left **/
+  static void eraseFromLeaf(Node *node, int index);
+
+  /** called by the copy constructor and copy assignment
+      @return a deep copy of the subtree at node, nullptr for nullptr**/
+  static std::unique_ptr<Node> copyNode(const Node *node);
+
+  /** called by rebuildBalanced
+      @post every item of the subtree at node is moved to the back of items, in order**/
+  static void moveItems(Node *node, std::vector<T> &items);
+
+  /** called by buildFromSorted
+      @return the most items a tree of the given height holds, (2 * MinDegree)^height - 1,
+              or more than any int once that overflows**/
+  static long long capacity(int height);
+
+  /** called by buildFromSorted
+      @param first the first item of the subtree; moved past its items
+      @param count the number of items of the subtree
+      @param height the height of the subtree
+      @param is_root the subtree is the whole tree, whose root may hold a single item
+      @return the root of a subtree holding those items, each node between half and
+              completely full, every leaf at the given height**/
+  template <class ForwardIt>
+  static std::unique_ptr<Node> buildNode(ForwardIt &first, long long count, int height, bool is_root);
+
+  /** called by lower_bound and upper_bound
+      @param past_equal skip items equal to key too
+      @return an iterator to the first item not less than key (greater than key when past_equal)**/
+  template <class K>
+  const_iterator seek(const K &key, bool past_equal) const;
+};
+
+#include "BTree.cpp"
+#endif
@@ -0,0 +1,97 @@
+/** @file BalancePolicy.cpp */
+
+#include "BalancePolicy.hpp"
+#include <algorithm>
+
+/*NO BALANCE*/
+
+template <class T>
+std::shared_ptr<BinaryNode<T>> NoBalance::rebalance(std::shared_ptr<BinaryNode<T>> node_ptr)
+{
+  if (node_ptr != nullptr)
+  {
+    int left_height = node_ptr->getLeftChildPtr() == nullptr ? 0 : node_ptr->getLeftChildPtr()->getHeight();
+    int right_height = node_ptr->getRightChildPtr() == nullptr ? 0 : node_ptr->getRightChildPtr()->getHeight();
+    node_ptr->setHeight(1 + std::max(left_height, right_height));
+  }
+  return node_ptr;
+} // end rebalance
+
+
+/*NO AUGMENT*/
+
+template <class T>
+void NoAugment::update(BinaryNode<T> &node)
+{
+} // end update
+
+
+/*AVL*/
+
+template <class Augment>
+template <class T>
+std::shared_ptr<BinaryNode<T>> AugmentedAvlBalance<Augment>::rebalance(std::shared_ptr<BinaryNode<T>> node_ptr)
+{
+  if (node_ptr == nullptr)
+    return node_ptr;
+
+  updateHeight(node_ptr);
+  int balance = heightOf(node_ptr->getLeftChildPtr()) - heightOf(node_ptr->getRightChildPtr());
+
+  if (balance > 1)
+  {
+    // Left heavy: a left-right case needs the left child rotated first
+    std::shared_ptr<BinaryNode<T>> left_ptr = node_ptr->getLeftChildPtr();
+    if (heightOf(left_ptr->getLeftChildPtr()) < heightOf(left_ptr->getRightChildPtr()))
+      node_ptr->setLeftChildPtr(rotateLeft(left_ptr));
+    return rotateRight(node_ptr);
+  }
+  else if (balance < -1)
+  {
+    // Right heavy: a right-left case needs the right child rotated first
+    std::shared_ptr<BinaryNode<T>> right_ptr = node_ptr->getRightChildPtr();
+    if (heightOf(right_ptr->getRightChildPtr()) < heightOf(right_ptr->getLeftChildPtr()))
+      node_ptr->setRightChildPtr(rotateRight(right_ptr));
+    return rotateLeft(node_ptr);
+  }
+  return node_ptr;
+} // end rebalance
+
+template <class Augment>
+template <class T>
+int AugmentedAvlBalance<Augment>::heightOf(const std::shared_ptr<BinaryNode<T>> &node_ptr)
+{
+  return node_ptr == nullptr ? 0 : node_ptr->getHeight();
+} // end heightOf
+
+template <class Augment>
+template <class T>
+void AugmentedAvlBalance<Augment>::updateHeight(const std::shared_ptr<BinaryNode<T>> &node_ptr)
+{
+  node_ptr->setHeight(1 + std::max(heightOf(node_ptr->getLeftChildPtr()), heightOf(node_ptr->getRightChildPtr())));
+  Augment::update(*node_ptr);
+} // end updateHeight
+
+template <class Augment>
+template <class T>
+std::shared_ptr<BinaryNode<T>> AugmentedAvlBalance<Augment>::rotateLeft(std::shared_ptr<BinaryNode<T>> node_ptr)
+{
+  std::shared_ptr<BinaryNode<T>> pivot_ptr = node_ptr->getRightChildPtr();
+  node_ptr->setRightChildPtr(pivot_ptr->getLeftChildPtr());
+  pivot_ptr->setLeftChildPtr(node_ptr);
+  updateHeight(node_ptr);
+  updateHeight(pivot_ptr);
+  return pivot_ptr;
+} // end rotateLeft
+
+template <class Augment>
+template <class T>
+std::shared_ptr<BinaryNode<T>> AugmentedAvlBalance<Augment>::rotateRight(std::shared_ptr<BinaryNode<T>> node_ptr)
+{
+  std::shared_ptr<BinaryNode<T>> pivot_ptr = node_ptr->getLeftChildPtr();
+  node_ptr->setLeftChildPtr(pivot_ptr->getRightChildPtr());
+  pivot_ptr->setRightChildPtr(node_ptr);
+  updateHeight(node_ptr);
+  updateHeight(pivot_ptr);
+  return pivot_ptr;
+} // end rotateRight
@@ -0,0 +1,67 @@
+/** Balancing policies for BinarySearchTree.
+ A policy is passed as the second template argument of BinarySearchTree and is
+ asked to rebalance every subtree root on the way back up from an add or remove.
+ @file BalancePolicy.hpp */
+
+#ifndef BALANCE_POLICY_
+#define BALANCE_POLICY_
+
+#include "BinaryNode.hpp"
+#include <memory>
+
+/** Plain BST: nodes stay where they are placed. */
+struct NoBalance
+{
+  /** @param node_ptr the root of a subtree whose children may have changed
+      @post the height of node_ptr is recomputed from its children
+      @return node_ptr, never rotated **/
+  template <class T>
+  static std::shared_ptr<BinaryNode<T>> rebalance(std::shared_ptr<BinaryNode<T>> node_ptr);
+};
+
+/** Augment hook for trees that keep no per-subtree summary. */
+struct NoAugment
+{
+  /** @post nothing, node has no summary to recompute **/
+  template <class T>
+  static void update(BinaryNode<T> &node);
+};
+
+/** AVL tree: the heights of the two subtrees of any node differ by at most 1,
+    so the height of the tree stays O(log n) on every add and remove.
+    Augment::update(node) is called every time the height of a node is
+    recomputed, after its children are final, so an item can carry a summary
+    of its subtree (counts, sums) that stays correct through rotations. */
+template <class Augment>
+struct AugmentedAvlBalance
+{
+  /** @param node_ptr the root of a subtree whose children may have changed
+      @pre both subtrees of node_ptr are AVL trees whose heights differ by at most 2
+      @post the height of node_ptr is updated, and rotated if it was out of balance
+      @return the new root of the subtree **/
+  template <class T>
+  static std::shared_ptr<BinaryNode<T>> rebalance(std::shared_ptr<BinaryNode<T>> node_ptr);
+
+  /** @return the height of the subtree, 0 for nullptr **/
+  template <class T>
+  static int heightOf(const std::shared_ptr<BinaryNode<T>> &node_ptr);
+
+  /** @post the height of node_ptr, and its Augment summary, are recomputed from its children **/
+  template <class T>
+  static void updateHeight(const std::shared_ptr<BinaryNode<T>> &node_ptr);
+
+  /** @pre node_ptr has a right child
+      @return the right child, which is now the root of the subtree **/
+  template <class T>
+  static std::shared_ptr<BinaryNode<T>> rotateLeft(std::shared_ptr<BinaryNode<T>> node_ptr);
+
+  /** @pre node_ptr has a left child
+      @return the left child, which is now the root of the subtree **/
+  template <class T>
+  static std::shared_ptr<BinaryNode<T>> rotateRight(std::shared_ptr<BinaryNode<T>> node_ptr);
+};
+
+using AvlBalance = AugmentedAvlBalance<NoAugment>;
+
+#include "BalancePolicy.cpp"
+#endif
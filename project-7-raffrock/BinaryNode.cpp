@@ -9,39 +9,87 @@
 
 template<class T>
 BinaryNode<T>::BinaryNode()
-      : item(nullptr), leftChildPtr(nullptr), rightChildPtr(nullptr)
+      : data(nullptr), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
 { }  // end default constructor
 
 template<class T>
 BinaryNode<T>::BinaryNode(const T& anItem)
-      : item(anItem), leftChildPtr(nullptr), rightChildPtr(nullptr)
+      : data(anItem), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
+{ }  // end constructor
+
+template<class T>
+BinaryNode<T>::BinaryNode(T&& anItem)
+      : data(std::move(anItem)), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
+{ }  // end constructor
+
+template<class T>
+template<class... Args>
+BinaryNode<T>::BinaryNode(std::in_place_t, Args&&... args)
+      : data(std::forward<Args>(args)...), leftChildPtr(nullptr), rightChildPtr(nullptr), height(1)
 { }  // end constructor
 
 template<class T>
 BinaryNode<T>::BinaryNode(const T& anItem,
                                     std::shared_ptr<BinaryNode<T>> leftPtr,
                                     std::shared_ptr<BinaryNode<T>> rightPtr)
-      : item(anItem), leftChildPtr(leftPtr), rightChildPtr(rightPtr)
+      : data(anItem), leftChildPtr(leftPtr), rightChildPtr(rightPtr), height(1)
 { }  // end constructor
 
 template<class T>
 void BinaryNode<T>::setItem(const T& anItem)
 {
-   item = anItem;
+   data = anItem;
+}  // end setItem
+
+template<class T>
+void BinaryNode<T>::setItem(T&& anItem)
+{
+   data = std::move(anItem);
 }  // end setItem
 
 template<class T>
 T BinaryNode<T>::getItem() const
 {
-   return item;
+   return data;
 }  // end getItem
 
+template<class T>
+const T& BinaryNode<T>::item() const
+{
+   return data;
+}  // end item
+
+template<class T>
+T& BinaryNode<T>::item()
+{
+   return data;
+}  // end item
+
+template<class T>
+template<class... Args>
+void BinaryNode<T>::emplace(Args&&... args)
+{
+   data = T(std::forward<Args>(args)...);
+}  // end emplace
+
 template<class T>
 bool BinaryNode<T>::isLeaf() const
 {
    return ((leftChildPtr == nullptr) && (rightChildPtr == nullptr));
 }
 
+template<class T>
+int BinaryNode<T>::getHeight() const
+{
+   return height;
+}  // end getHeight
+
+template<class T>
+void BinaryNode<T>::setHeight(int newHeight)
+{
+   height = newHeight;
+}  // end setHeight
+
 template<class T>
 void BinaryNode<T>::setLeftChildPtr(std::shared_ptr<BinaryNode<T>> leftPtr)
 {
@@ -55,13 +103,13 @@ void BinaryNode<T>::setRightChildPtr(std::shared_ptr<BinaryNode<T>> rightPtr)
 }  // end setRightChildPtr
 
 template<class T>
-std::shared_ptr<BinaryNode<T>> BinaryNode<T>::getLeftChildPtr() const
+const std::shared_ptr<BinaryNode<T>>& BinaryNode<T>::getLeftChildPtr() const
 {
    return leftChildPtr;
 }  // end getLeftChildPtr		
 
 template<class T>
-std::shared_ptr<BinaryNode<T>> BinaryNode<T>::getRightChildPtr() const
+const std::shared_ptr<BinaryNode<T>>& BinaryNode<T>::getRightChildPtr() const
 {
    return rightChildPtr;
 }  // end getRightChildPtr		
@@ -10,27 +10,47 @@
 #define BINARY_NODE_
 
 #include <memory>
+#include <utility>
 
 template<class T>
 class BinaryNode
 {   
 private:
-   T item;           // Data portion
+   T data;           // Data portion
    std::shared_ptr<BinaryNode<T>> leftChildPtr;   // Pointer to left child
    std::shared_ptr<BinaryNode<T>> rightChildPtr;  // Pointer to right child
+   int height;       // Height of the subtree rooted here, kept by balancing policies
 
 public:
    BinaryNode();
    BinaryNode(const T& anItem);
+   BinaryNode(T&& anItem);
+   /** the item is constructed in place from args, without a temporary T */
+   template<class... Args>
+   explicit BinaryNode(std::in_place_t, Args&&... args);
    BinaryNode(const T& anItem, std::shared_ptr<BinaryNode<T>> leftPtr, std::shared_ptr<BinaryNode<T>> rightPtr);
 
    void setItem(const T& anItem);
+   void setItem(T&& anItem);
    T getItem() const;
+
+   /** In-place access to the item, so visiting a node does not copy it.
+       A mutable item must keep the same key, or the tree order breaks. */
+   const T& item() const;
+   T& item();
+
+   /** @post the item is replaced by a T constructed from args */
+   template<class... Args>
+   void emplace(Args&&... args);
    
    bool isLeaf() const;
 
-   std::shared_ptr<BinaryNode<T>> getLeftChildPtr() const;
-   std::shared_ptr<BinaryNode<T>> getRightChildPtr() const;
+   int getHeight() const;
+   void setHeight(int newHeight);
+
+   // returned by reference, so walking down does not copy reference counts
+   const std::shared_ptr<BinaryNode<T>>& getLeftChildPtr() const;
+   const std::shared_ptr<BinaryNode<T>>& getRightChildPtr() const;
    
    void setLeftChildPtr(std::shared_ptr<BinaryNode<T>> leftPtr);
    void setRightChildPtr(std::shared_ptr<BinaryNode<T>> rightPtr);
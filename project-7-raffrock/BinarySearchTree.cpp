@@ -1,58 +1,106 @@
 #include "BinarySearchTree.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <type_traits>
 #include <vector>
+#include <utility>
 
 
 /*CONSTRUCTRS*/
 
-template <class T>
-BinarySearchTree<T>::BinarySearchTree() : root_ptr_(nullptr)
+template <class T, class Balance>
+BinarySearchTree<T, Balance>::BinarySearchTree() : root_ptr_(nullptr), node_count_(0)
 {
 } // end default constructor
 
-template <class T>
-BinarySearchTree<T>::BinarySearchTree(const T &root_item)
-    : root_ptr_(std::make_shared<BinaryNode<T>>(root_item, nullptr, nullptr))
+template <class T, class Balance>
+BinarySearchTree<T, Balance>::BinarySearchTree(const T &root_item)
+    : root_ptr_(Balance::rebalance(std::make_shared<BinaryNode<T>>(root_item, nullptr, nullptr))), node_count_(1)
 {
 } // end constructor
 
-template <class T>
-BinarySearchTree<T>::BinarySearchTree(const BinarySearchTree &another_tree)
+template <class T, class Balance>
+BinarySearchTree<T, Balance>::BinarySearchTree(const BinarySearchTree &another_tree)
+    : node_count_(another_tree.node_count_)
 {
-  root_ptr_ = copyTree(another_tree.root_ptr_); // Call helper method
+  root_ptr_ = copyTreeParallel(another_tree.root_ptr_, node_count_, parallelTasks()); // Call helper method
 } // end copy constructor
 
+template <class T, class Balance>
+BinarySearchTree<T, Balance>::BinarySearchTree(BinarySearchTree &&another_tree) noexcept
+    : root_ptr_(std::move(another_tree.root_ptr_)), node_count_(another_tree.node_count_)
+{
+  another_tree.root_ptr_ = nullptr;
+  another_tree.node_count_ = 0;
+} // end move constructor
+
+template <class T, class Balance>
+BinarySearchTree<T, Balance>::~BinarySearchTree()
+{
+  releaseNodes(std::move(root_ptr_));
+} // end destructor
+
+template <class T, class Balance>
+BinarySearchTree<T, Balance> &BinarySearchTree<T, Balance>::operator=(const BinarySearchTree &another_tree)
+{
+  if (this != &another_tree)
+  {
+    // copy first, so a failed copy leaves this tree as it was
+    BinarySearchTree copy(another_tree);
+    *this = std::move(copy);
+  }
+  return *this;
+} // end copy assignment
+
+template <class T, class Balance>
+BinarySearchTree<T, Balance> &BinarySearchTree<T, Balance>::operator=(BinarySearchTree &&another_tree) noexcept
+{
+  if (this != &another_tree)
+  {
+    releaseNodes(std::move(root_ptr_));
+    root_ptr_ = std::move(another_tree.root_ptr_);
+    node_count_ = another_tree.node_count_;
+    another_tree.root_ptr_ = nullptr;
+    another_tree.node_count_ = 0;
+  }
+  return *this;
+} // end move assignment
+
 
 
 /*PUBLIC METHODS*/
 
  /** @return root_ptr_ **/
-template <class T>
-std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::getRoot() const
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::getRoot() const
 {
   return root_ptr_;
 }
 
 /** @return true if the BinarySearchTree is emtpy, false otherwise **/
-template <class T>
-bool BinarySearchTree<T>::isEmpty() const
+template <class T, class Balance>
+bool BinarySearchTree<T, Balance>::isEmpty() const
 {
   return root_ptr_ == nullptr;
 } // end isEmpty
 
 
 /** @return the height of the BST structure as the number of nodes on the longest path from root to leaf**/
-template <class T>
-int BinarySearchTree<T>::getHeight() const
+template <class T, class Balance>
+int BinarySearchTree<T, Balance>::getHeight() const
 {
-  return this->getHeightHelper(root_ptr_); // Call helper method
+  return root_ptr_ == nullptr ? 0 : root_ptr_->getHeight();
 } // end getHeight
 
 
 /** @return the number of Nodes in the BST structure**/
-template <class T>
-int BinarySearchTree<T>::getNumberOfNodes() const
+template <class T, class Balance>
+int BinarySearchTree<T, Balance>::getNumberOfNodes() const
 {
-  return this->getNumberOfNodesHelper(root_ptr_); // Call helper method
+  return node_count_;
 } // end getNumberOfNodes
 
 
@@ -63,52 +111,258 @@ int BinarySearchTree<T>::getNumberOfNodes() const
               and all items in its right subtree are > 
               Note: > and < would need to be overloaded for self made data types
     **/
-template <class T>
-void BinarySearchTree<T>::add(const T &new_entry)
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::add(const T &new_entry)
 {
   std::shared_ptr<BinaryNode<T>> new_node_ptr = std::make_shared<BinaryNode<T>>(new_entry);
   root_ptr_ = placeNode(root_ptr_, new_node_ptr);
+  node_count_++;
+} // end add
+
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::add(T &&new_entry)
+{
+  std::shared_ptr<BinaryNode<T>> new_node_ptr = std::make_shared<BinaryNode<T>>(std::move(new_entry));
+  root_ptr_ = placeNode(root_ptr_, new_node_ptr);
+  node_count_++;
 } // end add
 
+template <class T, class Balance>
+template <class... Args>
+void BinarySearchTree<T, Balance>::emplace(Args &&...args)
+{
+  std::shared_ptr<BinaryNode<T>> new_node_ptr = std::make_shared<BinaryNode<T>>(std::in_place, std::forward<Args>(args)...);
+  root_ptr_ = placeNode(root_ptr_, new_node_ptr);
+  node_count_++;
+} // end emplace
+
 
   /** @param entry to be removed from the BST
       @post entry is removed from the BST and retaining its
               BST property, s.t. at any node, all Nodes in
               its left subtree are < the item at that node
               and all items in its right subtree are >**/
-template <class T>
-bool BinarySearchTree<T>::remove(const T &entry)
+template <class T, class Balance>
+bool BinarySearchTree<T, Balance>::remove(const T &entry)
 {
   bool is_successful = false;
   // call may change is_successful
   root_ptr_ = removeValue(root_ptr_, entry, is_successful);
+  if (is_successful)
+    node_count_--;
   return is_successful;
 } // end remove
 
 
   /** @param entry to be found in the BST
       @return true if entry is found in the BST, false otherwise**/
-template <class T>
-bool BinarySearchTree<T>::contains(const T &entry) const
+template <class T, class Balance>
+bool BinarySearchTree<T, Balance>::contains(const T &entry) const
 {
   return (findNode(root_ptr_, entry) != nullptr);
 } // end contains
 
+  /** Heterogeneous lookup: key may be any type that T can be compared
+      against with == and > (e.g. a std::string_view for a name-ordered T),
+      so no temporary T has to be built just to search.
+      @param key the key to be found in the BST
+      @return a pointer to the node whose item equals key, nullptr if not found**/
+template <class T, class Balance>
+template <class K>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::find(const K &key) const
+{
+  return findNode(root_ptr_, key);
+} // end find
+
+  /** @param key the key of the entry to be removed from the BST
+      @post the entry equal to key is removed from the BST retaining its BST property
+      @return true if an entry was removed, false otherwise**/
+template <class T, class Balance>
+template <class K>
+bool BinarySearchTree<T, Balance>::removeKey(const K &key)
+{
+  bool is_successful = false;
+  root_ptr_ = removeValue(root_ptr_, key, is_successful);
+  if (is_successful)
+    node_count_--;
+  return is_successful;
+} // end removeKey
+
+/** @post the tree is empty, every node is released in one sweep**/
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::clear()
+{
+  releaseNodes(std::move(root_ptr_));
+  root_ptr_ = nullptr;
+  node_count_ = 0;
+} // end clear
+
 /**Display preorder traversal through the BST**/
-template <class T>
-void BinarySearchTree<T>::displayPreorder()
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::displayPreorder()
 {
   preorderHelper(root_ptr_);
   std::cout << std::endl;
 } //end displayPreorder
 
+/** @return an iterator to the smallest item, end() if the tree is empty **/
+template <class T, class Balance>
+typename BinarySearchTree<T, Balance>::const_iterator BinarySearchTree<T, Balance>::begin() const
+{
+  const_iterator it(root_ptr_.get());
+  if (root_ptr_ != nullptr)
+    it.descendLeft(root_ptr_.get());
+  return it;
+} // end begin
+
+/** @return the past-the-end iterator **/
+template <class T, class Balance>
+typename BinarySearchTree<T, Balance>::const_iterator BinarySearchTree<T, Balance>::end() const
+{
+  return const_iterator(root_ptr_.get());
+} // end end
+
+/** @param key the key to be searched for
+    @return an iterator to the first item not less than key, end() if none**/
+template <class T, class Balance>
+template <class K>
+typename BinarySearchTree<T, Balance>::const_iterator BinarySearchTree<T, Balance>::lower_bound(const K &key) const
+{
+  // Walk down like findNode; the answer is the last node where the walk went left,
+  // so the path is cut back to that node at the end
+  const_iterator it(root_ptr_.get());
+  std::size_t answer_depth = 0;
+  const BinaryNode<T> *current = root_ptr_.get();
+  while (current != nullptr)
+  {
+    it.path_.push_back(current);
+    if (current->item() == key)
+      return it; // Found, nothing smaller can follow
+    else if (current->item() > key)
+    {
+      answer_depth = it.path_.size();
+      current = current->getLeftChildPtr().get();
+    }
+    else
+      current = current->getRightChildPtr().get();
+  }
+  it.path_.resize(answer_depth);
+  return it;
+} // end lower_bound
+
+/** @param key the key to be searched for
+    @return an iterator to the first item greater than key, end() if none**/
+template <class T, class Balance>
+template <class K>
+typename BinarySearchTree<T, Balance>::const_iterator BinarySearchTree<T, Balance>::upper_bound(const K &key) const
+{
+  const_iterator it(root_ptr_.get());
+  std::size_t answer_depth = 0;
+  const BinaryNode<T> *current = root_ptr_.get();
+  while (current != nullptr)
+  {
+    it.path_.push_back(current);
+    if (current->item() > key)
+    {
+      answer_depth = it.path_.size();
+      current = current->getLeftChildPtr().get();
+    }
+    else
+      current = current->getRightChildPtr().get();
+  }
+  it.path_.resize(answer_depth);
+  return it;
+} // end upper_bound
+
+/** @param key the key to be searched for
+    @return the range [lower_bound(key), upper_bound(key)), empty if key is absent**/
+template <class T, class Balance>
+template <class K>
+std::pair<typename BinarySearchTree<T, Balance>::const_iterator, typename BinarySearchTree<T, Balance>::const_iterator>
+BinarySearchTree<T, Balance>::equal_range(const K &key) const
+{
+  const_iterator first = lower_bound(key);
+  // items are unique, so the range holds at most one item
+  const_iterator last = first;
+  if (last != end() && *last == key)
+    ++last;
+  return {first, last};
+} // end equal_range
+
+  /** @post the existing nodes are relinked into a perfectly balanced shape:
+             every node is the middle of its inorder range. Runs in O(n),
+             no item is copied and no node is allocated.**/
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::rebuildBalanced()
+{
+  // Collect the nodes in inorder, which is already sorted
+  std::vector<std::shared_ptr<BinaryNode<T>>> nodes;
+  nodes.reserve(node_count_);
+  std::vector<std::shared_ptr<BinaryNode<T>>> node_stack;
+  std::shared_ptr<BinaryNode<T>> current_ptr = root_ptr_;
+  while (current_ptr != nullptr || !node_stack.empty())
+  {
+    while (current_ptr != nullptr)
+    {
+      node_stack.push_back(current_ptr);
+      current_ptr = current_ptr->getLeftChildPtr();
+    }
+    current_ptr = node_stack.back();
+    node_stack.pop_back();
+    nodes.push_back(current_ptr);
+    current_ptr = current_ptr->getRightChildPtr();
+  }
+
+  root_ptr_ = linkBalanced(nodes, 0, static_cast<int>(nodes.size()) - 1);
+} // end rebuildBalanced
+
+  /** @param first, last a range of items sorted ascending, without duplicates;
+             pass move iterators to move the items into the tree
+      @post the tree holds exactly those items, in a perfectly balanced shape.
+            Runs in O(n), items are not compared.**/
+template <class T, class Balance>
+template <class InputIt>
+void BinarySearchTree<T, Balance>::buildFromSorted(InputIt first, InputIt last)
+{
+  using Category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::random_access_iterator_tag, Category>::value)
+  {
+    // Any subrange can be reached directly, so both halves can be built at once
+    int count = static_cast<int>(last - first);
+    std::shared_ptr<BinaryNode<T>> new_root_ptr = buildBalanced(first, count, parallelTasks());
+    clear();
+    root_ptr_ = std::move(new_root_ptr);
+    node_count_ = count;
+  }
+  else
+  {
+    std::vector<std::shared_ptr<BinaryNode<T>>> nodes;
+    for (; first != last; ++first)
+      nodes.push_back(std::make_shared<BinaryNode<T>>(*first));
+
+    clear();
+    root_ptr_ = linkBalanced(nodes, 0, static_cast<int>(nodes.size()) - 1);
+    node_count_ = static_cast<int>(nodes.size());
+  }
+} // end buildFromSorted
+
 /**
  * @param: sets the root pointer to the parameter
+ * @pre: the items under new_root_ptr are in BST order
+ * @post: the node count is recomputed; heights, balance and Augment summaries are restored, O(n)
  */
-template <class T>
-void BinarySearchTree<T>::setRoot(std::shared_ptr<BinaryNode<T>> new_root_ptr)
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::setRoot(std::shared_ptr<BinaryNode<T>> new_root_ptr)
 {
   root_ptr_ = new_root_ptr;
+  node_count_ = getNumberOfNodesHelper(root_ptr_);
+  // An arbitrary shape can be further out of balance than the policy's
+  // rotations repair, so a balanced tree is relinked; every node then goes
+  // through Balance::rebalance, which also refreshes the Augment summaries
+  if constexpr (std::is_same<Balance, NoBalance>::value)
+    refreshHeights(root_ptr_);
+  else
+    rebuildBalanced();
 }
 
 
@@ -118,89 +372,246 @@ void BinarySearchTree<T>::setRoot(std::shared_ptr<BinaryNode<T>> new_root_ptr)
 /*PRIVATE METHODS*/
 
 
-template <class T>
-void BinarySearchTree<T>::preorderHelper(std::shared_ptr<BinaryNode<T>> node)
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::preorderHelper(std::shared_ptr<BinaryNode<T>> node)
 {
-  if (node == nullptr)
+  // Explicit stack: right child is pushed first so the left subtree is printed first
+  std::vector<const BinaryNode<T> *> node_stack;
+  if (node != nullptr)
+    node_stack.push_back(node.get());
+  while (!node_stack.empty())
   {
-    return;
+    const BinaryNode<T> *current = node_stack.back();
+    node_stack.pop_back();
+    std::cout << current->item() << " ";
+    if (current->getRightChildPtr() != nullptr)
+      node_stack.push_back(current->getRightChildPtr().get());
+    if (current->getLeftChildPtr() != nullptr)
+      node_stack.push_back(current->getLeftChildPtr().get());
   }
-  std::cout << node->getItem() << " ";
-  preorderHelper(node->getLeftChildPtr());
-  preorderHelper(node->getRightChildPtr());
 }
 
 
+ /** called by rebuildBalanced
+      @param nodes every node of the tree, in inorder
+      @param first index of the first node of the subtree in nodes
+      @param last index of the last node of the subtree in nodes
+      @post nodes[first..last] are linked into a balanced subtree
+      @return a pointer to the root of that subtree, nullptr if first > last
+     **/
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::linkBalanced(const std::vector<std::shared_ptr<BinaryNode<T>>> &nodes, int first, int last)
+{
+  if (first > last)
+    return nullptr;
+
+  // Recursion depth is log n, the subtrees halve every call
+  int mid = first + (last - first) / 2;
+  std::shared_ptr<BinaryNode<T>> mid_ptr = nodes[mid];
+  mid_ptr->setLeftChildPtr(linkBalanced(nodes, first, mid - 1));
+  mid_ptr->setRightChildPtr(linkBalanced(nodes, mid + 1, last));
+  // Already balanced: the policy only refreshes its bookkeeping here
+  return Balance::rebalance(mid_ptr);
+} // end linkBalanced
+
+
  /** called by copy constructor
       @param old_tee_root_ptr a pointer to the root of the tree to be copied
       @post recursively copies every node in the tree pointed to by the parameter pointer
       @return a pointer to the root of the copied subtree
      **/
-template <class T>
-std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::copyTree(const std::shared_ptr<BinaryNode<T>> old_tee_root_ptr) const
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::copyTree(const std::shared_ptr<BinaryNode<T>> old_tee_root_ptr) const
 {
-  std::shared_ptr<BinaryNode<T>> new_tree_ptr;
+  if (old_tee_root_ptr == nullptr)
+    return nullptr;
+
+  // Copy tree nodes during a preorder traversal, with an explicit stack of
+  // (original node, its copy) pairs whose children are still to be copied
+  std::shared_ptr<BinaryNode<T>> new_tree_ptr = std::make_shared<BinaryNode<T>>(old_tee_root_ptr->item(), nullptr, nullptr);
+  new_tree_ptr->setHeight(old_tee_root_ptr->getHeight());
+  std::vector<std::pair<const BinaryNode<T> *, BinaryNode<T> *>> node_stack;
+  node_stack.push_back({old_tee_root_ptr.get(), new_tree_ptr.get()});
 
-  // Copy tree nodes during a preorder traversal
-  if (old_tee_root_ptr != nullptr)
+  while (!node_stack.empty())
   {
-    // Copy node
-    new_tree_ptr = std::make_shared<BinaryNode<T>>(old_tee_root_ptr->getItem(), nullptr, nullptr);
-    new_tree_ptr->setLeftChildPtr(copyTree(old_tee_root_ptr->getLeftChildPtr()));
-    new_tree_ptr->setRightChildPtr(copyTree(old_tee_root_ptr->getRightChildPtr()));
-  } // end if
+    const BinaryNode<T> *old_node = node_stack.back().first;
+    BinaryNode<T> *new_node = node_stack.back().second;
+    node_stack.pop_back();
+
+    if (old_node->getLeftChildPtr() != nullptr)
+    {
+      const BinaryNode<T> *old_child = old_node->getLeftChildPtr().get();
+      new_node->setLeftChildPtr(std::make_shared<BinaryNode<T>>(old_child->item(), nullptr, nullptr));
+      new_node->getLeftChildPtr()->setHeight(old_child->getHeight());
+      node_stack.push_back({old_child, new_node->getLeftChildPtr().get()});
+    }
+    if (old_node->getRightChildPtr() != nullptr)
+    {
+      const BinaryNode<T> *old_child = old_node->getRightChildPtr().get();
+      new_node->setRightChildPtr(std::make_shared<BinaryNode<T>>(old_child->item(), nullptr, nullptr));
+      new_node->getRightChildPtr()->setHeight(old_child->getHeight());
+      node_stack.push_back({old_child, new_node->getRightChildPtr().get()});
+    }
+  }
 
   return new_tree_ptr;
 } // end copyTree
 
 
-  /** called by getHeight
+ /** called by copy constructor
+      @param old_tree_root_ptr a pointer to the root of the tree to be copied
+      @param node_estimate the number of nodes under old_tree_root_ptr, halved at every split
+      @param tasks how many threads this subtree may use
+      @post while both halves are large, the left subtree is copied by a new task and the right
+            one by this thread; smaller subtrees go to copyTree
+      @return a pointer to the root of the copied subtree
+     **/
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::copyTreeParallel(const std::shared_ptr<BinaryNode<T>> &old_tree_root_ptr, int node_estimate, unsigned tasks) const
+{
+  if (tasks < 2 || node_estimate < PARALLEL_THRESHOLD || old_tree_root_ptr == nullptr
+      || old_tree_root_ptr->getLeftChildPtr() == nullptr || old_tree_root_ptr->getRightChildPtr() == nullptr)
+    return copyTree(old_tree_root_ptr);
+
+  // The source is only read, so both subtrees can be walked at once.
+  // Splitting halves the task budget, so at most tasks threads run
+  const std::shared_ptr<BinaryNode<T>> &old_left_ptr = old_tree_root_ptr->getLeftChildPtr();
+  std::future<std::shared_ptr<BinaryNode<T>>> left_copy = std::async(std::launch::async, [this, &old_left_ptr, node_estimate, tasks]()
+                                                                     { return copyTreeParallel(old_left_ptr, node_estimate / 2, tasks / 2); });
+  std::shared_ptr<BinaryNode<T>> right_ptr = copyTreeParallel(old_tree_root_ptr->getRightChildPtr(), node_estimate / 2, tasks - tasks / 2);
+
+  std::shared_ptr<BinaryNode<T>> new_tree_ptr = std::make_shared<BinaryNode<T>>(old_tree_root_ptr->item(), left_copy.get(), right_ptr);
+  new_tree_ptr->setHeight(old_tree_root_ptr->getHeight());
+  return new_tree_ptr;
+} // end copyTreeParallel
+
+
+ /** called by buildFromSorted
+      @param first the first item of the subtree, in a random access range
+      @param count the number of items of the subtree
+      @param tasks how many threads this subtree may use
+      @post items first[0..count) are moved or copied into new nodes linked into a balanced subtree
+      @return a pointer to the root of that subtree, nullptr if count is 0
+     **/
+template <class T, class Balance>
+template <class RandomIt>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::buildBalanced(RandomIt first, int count, unsigned tasks)
+{
+  if (count <= 0)
+    return nullptr;
+
+  // Same shape as linkBalanced; recursion depth is log n
+  int mid = (count - 1) / 2;
+  std::shared_ptr<BinaryNode<T>> left_ptr;
+  std::shared_ptr<BinaryNode<T>> right_ptr;
+  if (tasks >= 2 && count >= PARALLEL_THRESHOLD)
+  {
+    // The halves touch disjoint items, so the left one can go to a new task
+    std::future<std::shared_ptr<BinaryNode<T>>> left_build = std::async(std::launch::async, [first, mid, tasks]()
+                                                                        { return buildBalanced(first, mid, tasks / 2); });
+    right_ptr = buildBalanced(first + (mid + 1), count - mid - 1, tasks - tasks / 2);
+    left_ptr = left_build.get();
+  }
+  else
+  {
+    left_ptr = buildBalanced(first, mid, 1);
+    right_ptr = buildBalanced(first + (mid + 1), count - mid - 1, 1);
+  }
+
+  std::shared_ptr<BinaryNode<T>> mid_ptr = std::make_shared<BinaryNode<T>>(*(first + mid));
+  mid_ptr->setLeftChildPtr(std::move(left_ptr));
+  mid_ptr->setRightChildPtr(std::move(right_ptr));
+  return Balance::rebalance(mid_ptr);
+} // end buildBalanced
+
+
+  /** @return the number of threads a copy or a build may use, at least 1 **/
+template <class T, class Balance>
+unsigned BinarySearchTree<T, Balance>::parallelTasks()
+{
+  unsigned threads = std::thread::hardware_concurrency();
+  return threads == 0 ? 1 : threads;
+} // end parallelTasks
+
+
+  /** called by setRoot
      @param subtree_ptr a pointer to the root of the current subtree
-     @return the height of the BST structure
+     @post the height stored in every node of the subtree is recomputed
+     @return the height of the subtree
      as the number of nodes on the longest path
      from root to leaf**/
-template <class T>
-int BinarySearchTree<T>::getHeightHelper(std::shared_ptr<BinaryNode<T>> subtree_ptr) const
+template <class T, class Balance>
+int BinarySearchTree<T, Balance>::refreshHeights(std::shared_ptr<BinaryNode<T>> subtree_ptr)
 {
   if (subtree_ptr == nullptr)
     return 0;
-  else
-    return 1 + std::max(getHeightHelper(subtree_ptr->getLeftChildPtr()), getHeightHelper(subtree_ptr->getRightChildPtr()));
-} // end getHeightHelper
+
+  // Preorder puts every parent before its children, so walking the
+  // list backwards visits children first
+  std::vector<BinaryNode<T> *> nodes;
+  nodes.push_back(subtree_ptr.get());
+  for (std::size_t i = 0; i < nodes.size(); i++)
+  {
+    if (nodes[i]->getLeftChildPtr() != nullptr)
+      nodes.push_back(nodes[i]->getLeftChildPtr().get());
+    if (nodes[i]->getRightChildPtr() != nullptr)
+      nodes.push_back(nodes[i]->getRightChildPtr().get());
+  }
+  for (std::size_t i = nodes.size(); i-- > 0;)
+  {
+    int left_height = nodes[i]->getLeftChildPtr() == nullptr ? 0 : nodes[i]->getLeftChildPtr()->getHeight();
+    int right_height = nodes[i]->getRightChildPtr() == nullptr ? 0 : nodes[i]->getRightChildPtr()->getHeight();
+    nodes[i]->setHeight(1 + std::max(left_height, right_height));
+  }
+  return subtree_ptr->getHeight();
+} // end refreshHeights
 
 
-/** called by getNumberOfNodes
+/** called by setRoot
      @param subtree_ptr a pointer to the root of the current subtree
      @return the number of nodes in the tree**/
-template <class T>
-int BinarySearchTree<T>::getNumberOfNodesHelper(std::shared_ptr<BinaryNode<T>> subtree_ptr) const
+template <class T, class Balance>
+int BinarySearchTree<T, Balance>::getNumberOfNodesHelper(std::shared_ptr<BinaryNode<T>> subtree_ptr) const
 {
-  if (subtree_ptr == nullptr)
-    return 0;
-  else
-    return 1 + getNumberOfNodesHelper(subtree_ptr->getLeftChildPtr()) + getNumberOfNodesHelper(subtree_ptr->getRightChildPtr());
+  int count = 0;
+  std::vector<const BinaryNode<T> *> node_stack;
+  if (subtree_ptr != nullptr)
+    node_stack.push_back(subtree_ptr.get());
+  while (!node_stack.empty())
+  {
+    const BinaryNode<T> *current = node_stack.back();
+    node_stack.pop_back();
+    count++;
+    if (current->getLeftChildPtr() != nullptr)
+      node_stack.push_back(current->getLeftChildPtr().get());
+    if (current->getRightChildPtr() != nullptr)
+      node_stack.push_back(current->getRightChildPtr().get());
+  }
+  return count;
 } // end getNumberOfNodesHelper
 
 
 /** called by add(new_entry)
       @param subtree_ptr a pointer to the subtree in which to place the new node
       @param new_node_ptr a pointer to the new node to be added to the tree
-      @post recursively places the new node as a leaf retaining the BST property
+      @post places the new node as a leaf retaining the BST property
       @return a pointer to the root of the subtree in which node was placed
      **/
-template <class T>
-std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::placeNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, std::shared_ptr<BinaryNode<T>> new_node_ptr)
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::placeNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, std::shared_ptr<BinaryNode<T>> new_node_ptr)
 {
-  if (subtree_ptr == nullptr)
-    return new_node_ptr;
-  else
+  // Walk down to the empty spot, remembering the path back up
+  std::vector<PathStep> path;
+  std::shared_ptr<BinaryNode<T>> current_ptr = subtree_ptr;
+  while (current_ptr != nullptr)
   {
-    if (subtree_ptr->getItem() > new_node_ptr->getItem())
-      subtree_ptr->setLeftChildPtr(placeNode(subtree_ptr->getLeftChildPtr(), new_node_ptr));
-    else
-      subtree_ptr->setRightChildPtr(placeNode(subtree_ptr->getRightChildPtr(), new_node_ptr));
-    return subtree_ptr;
+    bool go_left = current_ptr->item() > new_node_ptr->item();
+    path.push_back({current_ptr, go_left});
+    current_ptr = go_left ? current_ptr->getLeftChildPtr() : current_ptr->getRightChildPtr();
   }
+  // lets the policy set up the fresh leaf before relinking
+  return relinkPath(path, Balance::rebalance(new_node_ptr));
 } // end placeNode
 
 
@@ -209,20 +620,24 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::placeNode(std::shared_ptr<Bi
       @param target a reference to the item to be found
       @return a pointer to the node containing the target, nullptr if not found
      **/
-template <class T>
-std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::findNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, const T &target) const
+template <class T, class Balance>
+template <class K>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::findNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, const K &target) const
 {
-  // Uses a binary search
-  if (subtree_ptr == nullptr)
-    return subtree_ptr; // Not found
-  else if ((subtree_ptr->getItem() == target))
-    return subtree_ptr; // Found
-  else if (subtree_ptr->getItem() > target)
-    // Search left subtree
-    return findNode(subtree_ptr->getLeftChildPtr(), target);
-  else
-    // Search right subtree
-    return findNode(subtree_ptr->getRightChildPtr(), target);
+  // Uses a binary search; follows references to the child pointers so
+  // walking down does not touch any reference count
+  const std::shared_ptr<BinaryNode<T>> *current_ptr = &subtree_ptr;
+  while (*current_ptr != nullptr)
+  {
+    const T &item = (*current_ptr)->item();
+    if (item == target)
+      return *current_ptr; // Found
+    else if (item > target)
+      current_ptr = &(*current_ptr)->getLeftChildPtr(); // Search left subtree
+    else
+      current_ptr = &(*current_ptr)->getRightChildPtr(); // Search right subtree
+  }
+  return nullptr; // Not found
 } // end findNode
 
 
@@ -232,19 +647,18 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::findNode(std::shared_ptr<Bin
       @post removes the node containing the inorder successor
       @return a pointer to the subtree after inorder successor node has been deleted
      **/
-template <class T>
-std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeLeftmostNode(std::shared_ptr<BinaryNode<T>> node_ptr, T &inorder_successor)
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::removeLeftmostNode(std::shared_ptr<BinaryNode<T>> node_ptr, T &inorder_successor)
 {
-  if (node_ptr->getLeftChildPtr() == nullptr)
+  std::vector<PathStep> path;
+  while (node_ptr->getLeftChildPtr() != nullptr)
   {
-    inorder_successor = node_ptr->getItem();
-    return removeNode(node_ptr);
+    path.push_back({node_ptr, true});
+    node_ptr = node_ptr->getLeftChildPtr();
   }
-  else
-  {
-    node_ptr->setLeftChildPtr(removeLeftmostNode(node_ptr->getLeftChildPtr(), inorder_successor));
-    return node_ptr;
-  } // end if
+  // the node is about to be unlinked, so its item can be moved out
+  inorder_successor = std::move(node_ptr->item());
+  return relinkPath(path, removeNode(node_ptr));
 } // end removeLeftmostNode
 
 
@@ -254,8 +668,8 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeLeftmostNode(std::shar
       @post removed the node pointed to by parameter retaining the BST property
       @return a pointer to the subtree after node has been removed
      **/
-template <class T>
-std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeNode(std::shared_ptr<BinaryNode<T>> node_ptr)
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::removeNode(std::shared_ptr<BinaryNode<T>> node_ptr)
 {
   // Case 1) Node is a leaf - it is deleted
   if (node_ptr->isLeaf())
@@ -278,8 +692,8 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeNode(std::shared_ptr<B
     // Traditional way to remove a value in a node with two children
     T new_node_value;
     node_ptr->setRightChildPtr(removeLeftmostNode(node_ptr->getRightChildPtr(), new_node_value));
-    node_ptr->setItem(new_node_value);
-    return node_ptr;
+    node_ptr->setItem(std::move(new_node_value));
+    return Balance::rebalance(node_ptr);
   } // end if
 } // end removeNode
 
@@ -290,37 +704,156 @@ std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeNode(std::shared_ptr<B
       @param success a flag to indicate that item was successfully removed
       @return a pointer to the subtree in which target is found
      **/
-template <class T>
-std::shared_ptr<BinaryNode<T>> BinarySearchTree<T>::removeValue(std::shared_ptr<BinaryNode<T>> subtree_ptr, const T target, bool &success)
+template <class T, class Balance>
+template <class K>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::removeValue(std::shared_ptr<BinaryNode<T>> subtree_ptr, const K &target, bool &success)
 {
-  if (subtree_ptr == nullptr)
+  // Search down, remembering the path back up
+  std::vector<PathStep> path;
+  std::shared_ptr<BinaryNode<T>> current_ptr = subtree_ptr;
+  while (current_ptr != nullptr && !(current_ptr->item() == target))
   {
-    // Not found here
-    success = false;
-    return subtree_ptr;
+    bool go_left = current_ptr->item() > target;
+    path.push_back({current_ptr, go_left});
+    current_ptr = go_left ? current_ptr->getLeftChildPtr() : current_ptr->getRightChildPtr();
   }
-  if ((subtree_ptr->getItem() == target))
+
+  if (current_ptr == nullptr)
   {
-    // Item is in the root of some subtree
-    subtree_ptr = removeNode(subtree_ptr);
-    success = true;
+    // Not found, nothing changed
+    success = false;
     return subtree_ptr;
   }
-  else
+
+  // Item is in the root of some subtree
+  success = true;
+  return relinkPath(path, removeNode(current_ptr));
+} // end removeValue
+
+/** called by placeNode, removeValue and removeLeftmostNode
+      @param path the nodes from a subtree root down to the parent of a changed child
+      @param child_ptr the new child at the bottom of the path
+      @post the path is relinked bottom-up, and every node on it is handed to the balancing policy
+      @return a pointer to the root of the subtree after relinking
+     **/
+template <class T, class Balance>
+std::shared_ptr<BinaryNode<T>> BinarySearchTree<T, Balance>::relinkPath(const std::vector<PathStep> &path, std::shared_ptr<BinaryNode<T>> child_ptr)
+{
+  for (std::size_t i = path.size(); i-- > 0;)
   {
-    if (subtree_ptr->getItem() > target)
-    {
-      // Search the left subtree
-      subtree_ptr->setLeftChildPtr(removeValue(subtree_ptr->getLeftChildPtr(), target, success));
-    }
+    if (path[i].went_left)
+      path[i].node_ptr->setLeftChildPtr(child_ptr);
     else
+      path[i].node_ptr->setRightChildPtr(child_ptr);
+    child_ptr = Balance::rebalance(path[i].node_ptr);
+  }
+  return child_ptr;
+} // end relinkPath
+
+/** called by the destructor, clear and buildFromSorted
+      @param subtree_ptr the root of a subtree to be released
+      @post every node only reachable from subtree_ptr is freed, one at a time with an explicit
+            stack, so a deep tree cannot overflow the call stack through nested shared_ptr destructors.
+            Nodes also held from outside the tree are left intact.
+     **/
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::releaseNodes(std::shared_ptr<BinaryNode<T>> subtree_ptr)
+{
+  std::vector<std::shared_ptr<BinaryNode<T>>> node_stack;
+  if (subtree_ptr != nullptr)
+    node_stack.push_back(std::move(subtree_ptr));
+  while (!node_stack.empty())
+  {
+    std::shared_ptr<BinaryNode<T>> node_ptr = std::move(node_stack.back());
+    node_stack.pop_back();
+    // Only detach children of a node that is freed right here
+    if (node_ptr.use_count() == 1)
     {
-      // Search the right subtree
-      subtree_ptr->setRightChildPtr(removeValue(subtree_ptr->getRightChildPtr(), target, success));
+      if (node_ptr->getLeftChildPtr() != nullptr)
+      {
+        node_stack.push_back(node_ptr->getLeftChildPtr());
+        node_ptr->setLeftChildPtr(nullptr);
+      }
+      if (node_ptr->getRightChildPtr() != nullptr)
+      {
+        node_stack.push_back(node_ptr->getRightChildPtr());
+        node_ptr->setRightChildPtr(nullptr);
+      }
     }
-    return subtree_ptr;
+  } // node_ptr is freed here, with no children left to free recursively
+} // end releaseNodes
+
+
+
+/*ITERATORS*/
+
+/** @post moves to the inorder successor, or to end() after the largest item **/
+template <class T, class Balance>
+typename BinarySearchTree<T, Balance>::const_iterator &BinarySearchTree<T, Balance>::const_iterator::operator++()
+{
+  const BinaryNode<T> *current = path_.back();
+  if (current->getRightChildPtr() != nullptr)
+  {
+    // Successor is the leftmost node of the right subtree
+    descendLeft(current->getRightChildPtr().get());
+    return *this;
   }
-} // end removeValue
+  // Otherwise climb until coming up from a left child
+  path_.pop_back();
+  while (!path_.empty() && path_.back()->getRightChildPtr().get() == current)
+  {
+    current = path_.back();
+    path_.pop_back();
+  }
+  return *this;
+} // end operator++
 
+/** @post moves to the inorder predecessor; from end() moves to the largest item **/
+template <class T, class Balance>
+typename BinarySearchTree<T, Balance>::const_iterator &BinarySearchTree<T, Balance>::const_iterator::operator--()
+{
+  if (path_.empty())
+  {
+    // From end(): the largest item is the rightmost node
+    if (root_ != nullptr)
+      descendRight(root_);
+    return *this;
+  }
+  const BinaryNode<T> *current = path_.back();
+  if (current->getLeftChildPtr() != nullptr)
+  {
+    // Predecessor is the rightmost node of the left subtree
+    descendRight(current->getLeftChildPtr().get());
+    return *this;
+  }
+  // Otherwise climb until coming up from a right child
+  path_.pop_back();
+  while (!path_.empty() && path_.back()->getLeftChildPtr().get() == current)
+  {
+    current = path_.back();
+    path_.pop_back();
+  }
+  return *this;
+} // end operator--
 
+/** @post pushes node_ptr and then its left spine onto path_ **/
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::const_iterator::descendLeft(const BinaryNode<T> *node_ptr)
+{
+  while (node_ptr != nullptr)
+  {
+    path_.push_back(node_ptr);
+    node_ptr = node_ptr->getLeftChildPtr().get();
+  }
+} // end descendLeft
 
+/** @post pushes node_ptr and then its right spine onto path_ **/
+template <class T, class Balance>
+void BinarySearchTree<T, Balance>::const_iterator::descendRight(const BinaryNode<T> *node_ptr)
+{
+  while (node_ptr != nullptr)
+  {
+    path_.push_back(node_ptr);
+    node_ptr = node_ptr->getRightChildPtr().get();
+  }
+} // end descendRight
@@ -2,16 +2,93 @@
 #define BINARY_SEARCH_TREE_
 
 #include "BinaryNode.hpp"
+#include "BalancePolicy.hpp"
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
 
-template <class T>
+/** Balance is a policy from BalancePolicy.hpp: NoBalance (the default) keeps
+    the plain BST behavior, AvlBalance keeps the height O(log n) on every
+    add and remove. **/
+template <class T, class Balance = NoBalance>
 class BinarySearchTree
 {
 public:
+  /** Bidirectional inorder iterator: visits the items in ascending order.
+      Holds the path from the root to its node, so ++ and -- are amortized O(1)
+      and never need parent pointers. Any add or remove invalidates it. **/
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() : root_(nullptr) {}
+
+    reference operator*() const { return path_.back()->item(); }
+    pointer operator->() const { return &path_.back()->item(); }
+
+    /** @post moves to the inorder successor, or to end() after the largest item **/
+    const_iterator &operator++();
+    const_iterator operator++(int)
+    {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    /** @post moves to the inorder predecessor; from end() moves to the largest item **/
+    const_iterator &operator--();
+    const_iterator operator--(int)
+    {
+      const_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &other) const { return node() == other.node(); }
+    bool operator!=(const const_iterator &other) const { return node() != other.node(); }
+
+  private:
+    friend class BinarySearchTree;
+
+    const BinaryNode<T> *root_;
+    // root first, current node last; empty at end()
+    std::vector<const BinaryNode<T> *> path_;
+
+    explicit const_iterator(const BinaryNode<T> *root) : root_(root) {}
+
+    const BinaryNode<T> *node() const { return path_.empty() ? nullptr : path_.back(); }
+
+    /** @post pushes node_ptr and then its left spine onto path_ **/
+    void descendLeft(const BinaryNode<T> *node_ptr);
+
+    /** @post pushes node_ptr and then its right spine onto path_ **/
+    void descendRight(const BinaryNode<T> *node_ptr);
+  };
+
+  using iterator = const_iterator;
+
   /*Constructors*/
   BinarySearchTree();                                     //default constructor
   BinarySearchTree(const T &root_item);                   //parameterized constructor
-  BinarySearchTree(const BinarySearchTree &another_tree); //copy constructor
+  BinarySearchTree(const BinarySearchTree &another_tree); //copy constructor, parallel for large trees
+  BinarySearchTree(BinarySearchTree &&another_tree) noexcept; //move constructor, leaves another_tree empty
+  ~BinarySearchTree();                                    //destructor
+
+  /** @post this tree holds a deep copy of another_tree's nodes; its old nodes are released
+      @return *this **/
+  BinarySearchTree &operator=(const BinarySearchTree &another_tree);
+
+  /** @post this tree takes over another_tree's nodes in O(1) and another_tree is left empty;
+            this tree's old nodes are released
+      @return *this **/
+  BinarySearchTree &operator=(BinarySearchTree &&another_tree) noexcept;
 
   /** @return root_ptr_ **/
   std::shared_ptr<BinaryNode<T>> getRoot() const;
@@ -19,10 +96,12 @@ public:
   /** @return true if the BinarySearchTree is emtpy, false otherwise **/
   bool isEmpty() const;
 
-  /** @return the height of the BST structure as the number of nodes on the longest path from root to leaf**/
+  /** @return the height of the BST structure as the number of nodes on the longest path from root to leaf
+      O(1): read from the root, whose height the balancing policy keeps up to date**/
   int getHeight() const;
 
-  /** @return the number of Nodes in the BST structure**/
+  /** @return the number of Nodes in the BST structure
+      O(1): the count is kept up to date by every operation**/
   int getNumberOfNodes() const;
 
   /** @param a new entry to be added to the BST
@@ -34,6 +113,15 @@ public:
     **/
   void add(const T &new_entry);
 
+  /** @param a new entry to be moved into the BST
+      @post as add(const T&), without copying the entry **/
+  void add(T &&new_entry);
+
+  /** @param args the arguments of a T constructor
+      @post as add(const T&), with the new entry constructed in place in its node **/
+  template <class... Args>
+  void emplace(Args &&...args);
+
   /** @param entry to be removed from the BST
       @post entry is removed from the BST and retaining its
               BST property, s.t. at any node, all Nodes in
@@ -46,33 +134,148 @@ public:
       @return true if entry is found in the BST, false otherwise**/
   bool contains(const T &entry) const;
 
+  /** Heterogeneous lookup: key may be any type that T can be compared
+      against with == and > (e.g. a std::string_view for a name-ordered T),
+      so no temporary T has to be built just to search.
+      @param key the key to be found in the BST
+      @return a pointer to the node whose item equals key, nullptr if not found**/
+  template <class K>
+  std::shared_ptr<BinaryNode<T>> find(const K &key) const;
+
+  /** @param key the key of the entry to be removed from the BST
+      @post the entry equal to key is removed from the BST retaining its BST property
+      @return true if an entry was removed, false otherwise**/
+  template <class K>
+  bool removeKey(const K &key);
+
+  /** @return an iterator to the smallest item, end() if the tree is empty **/
+  const_iterator begin() const;
+
+  /** @return the past-the-end iterator **/
+  const_iterator end() const;
+
+  /** Heterogeneous like find: key only needs == and > against T.
+      Each runs one O(height) descent.
+      @param key the key to be searched for
+      @return an iterator to the first item not less than key, end() if none**/
+  template <class K>
+  const_iterator lower_bound(const K &key) const;
+
+  /** @param key the key to be searched for
+      @return an iterator to the first item greater than key, end() if none**/
+  template <class K>
+  const_iterator upper_bound(const K &key) const;
+
+  /** @param key the key to be searched for
+      @return the range [lower_bound(key), upper_bound(key)), empty if key is absent**/
+  template <class K>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+
+  /** @post the tree is empty. Every node is released in one O(n) sweep with an
+            explicit stack, without searching or rebalancing.**/
+  void clear();
+
   /**Display preorder traversal through the BST**/
   void displayPreorder();
 
+  /** @post the existing nodes are relinked into a perfectly balanced shape:
+             every node is the middle of its inorder range. Runs in O(n),
+             no item is copied and no node is allocated.**/
+  void rebuildBalanced();
+
+  /** @param first, last a range of items sorted ascending, without duplicates;
+             pass move iterators to move the items into the tree
+      @post the tree holds exactly those items, in a perfectly balanced shape.
+            Runs in O(n), items are not compared. A random access range of at
+            least PARALLEL_THRESHOLD items is split across tasks.**/
+  template <class InputIt>
+  void buildFromSorted(InputIt first, InputIt last);
+
+  /** subtrees smaller than this are copied or built on the calling thread:
+      below it, starting a task costs more than the work it hands over **/
+  static constexpr int PARALLEL_THRESHOLD = 1 << 15;
+
+protected:
   /**
+   * Protected: a caller-built tree skips every invariant add keeps, so only
+   * a derived class that owns the nodes may hand one over.
    * @param: sets the root pointer to the parameter
+   * @pre: the items under new_root_ptr are in BST order
+   * @post: the node count is recomputed. Without balancing, the heights are
+   *        recomputed and the shape is kept; with a balancing policy, the
+   *        nodes are relinked as rebuildBalanced does, so the balance and
+   *        Augment summaries hold again. O(n) either way.
    */
   void setRoot(std::shared_ptr<BinaryNode<T>> new_root_ptr);
 
 private:
   std::shared_ptr<BinaryNode<T>> root_ptr_;
+  int node_count_;
+
+  /** one step of a walk down from the root: the node, and which child the walk took **/
+  struct PathStep
+  {
+    std::shared_ptr<BinaryNode<T>> node_ptr;
+    bool went_left;
+  };
+
+  /** called by placeNode, removeValue and removeLeftmostNode
+      @param path the nodes from a subtree root down to the parent of a changed child
+      @param child_ptr the new child at the bottom of the path
+      @post the path is relinked bottom-up, and every node on it is handed to the balancing policy
+      @return a pointer to the root of the subtree after relinking
+     **/
+  std::shared_ptr<BinaryNode<T>> relinkPath(const std::vector<PathStep> &path, std::shared_ptr<BinaryNode<T>> child_ptr);
+
+  /** called by the destructor, clear and buildFromSorted
+      @param subtree_ptr the root of a subtree to be released
+      @post every node only reachable from subtree_ptr is freed, one at a time with an explicit
+            stack, so a deep tree cannot overflow the call stack through nested shared_ptr destructors.
+            Nodes also held from outside the tree are left intact.
+     **/
+  static void releaseNodes(std::shared_ptr<BinaryNode<T>> subtree_ptr);
 
   /** called by copy constructor
       @param old_tee_root_ptr a pointer to the root of the tree to be copied
-      @post recursively copies every node in the tree pointed to by the parameter pointer
+      @post copies every node in the tree pointed to by the parameter pointer
       @return a pointer to the root of the copied subtree
      **/
   std::shared_ptr<BinaryNode<T>> copyTree(const std::shared_ptr<BinaryNode<T>> old_tee_root_ptr) const;
 
+  /** called by copy constructor
+      @param old_tree_root_ptr a pointer to the root of the tree to be copied
+      @param node_estimate the number of nodes under old_tree_root_ptr, halved at every split
+      @param tasks how many threads this subtree may use
+      @post while both halves are large, the left subtree is copied by a new task and the right
+            one by this thread; smaller subtrees go to copyTree
+      @return a pointer to the root of the copied subtree
+     **/
+  std::shared_ptr<BinaryNode<T>> copyTreeParallel(const std::shared_ptr<BinaryNode<T>> &old_tree_root_ptr, int node_estimate, unsigned tasks) const;
+
+  /** called by buildFromSorted
+      @param first the first item of the subtree, in a random access range
+      @param count the number of items of the subtree
+      @param tasks how many threads this subtree may use
+      @post items first[0..count) are moved or copied into new nodes linked into a balanced
+            subtree; with tasks to spare, the left half of a large range is built by a new task
+      @return a pointer to the root of that subtree, nullptr if count is 0
+     **/
+  template <class RandomIt>
+  static std::shared_ptr<BinaryNode<T>> buildBalanced(RandomIt first, int count, unsigned tasks);
+
+  /** @return the number of threads a copy or a build may use, at least 1 **/
+  static unsigned parallelTasks();
+
 
-  /** called by getHeight
+  /** called by setRoot
      @param subtree_ptr a pointer to the root of the current subtree
-     @return the height of the BST structure
+     @post the height stored in every node of the subtree is recomputed
+     @return the height of the subtree
      as the number of nodes on the longest path
      from root to leaf**/
-  int getHeightHelper(std::shared_ptr<BinaryNode<T>> subtree_ptr) const;
+  int refreshHeights(std::shared_ptr<BinaryNode<T>> subtree_ptr);
 
-  /** called by getNumberOfNodes
+  /** called by setRoot
      @param subtree_ptr a pointer to the root of the current subtree
      @return the number of nodes in the tree**/
   int getNumberOfNodesHelper(std::shared_ptr<BinaryNode<T>> subtree_ptr) const;
@@ -80,7 +283,7 @@ private:
   /** called by add(new_entry)
       @param subtree_ptr a pointer to the subtree in which to place the new node
       @param new_node_ptr a pointer to the new node to be added to the tree
-      @post recursively places the new node as a leaf retaining the BST property
+      @post places the new node as a leaf retaining the BST property
       @return a pointer to the root of the subtree in which node was placed
      **/
   std::shared_ptr<BinaryNode<T>> placeNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, std::shared_ptr<BinaryNode<T>> new_node_ptr);
@@ -92,7 +295,8 @@ private:
       @param success a flag to indicate that item was successfully removed
       @return a pointer to the subtree in which target is found
      **/
-  std::shared_ptr<BinaryNode<T>> removeValue(std::shared_ptr<BinaryNode<T>> subtree_ptr, const T target, bool &success);
+  template <class K>
+  std::shared_ptr<BinaryNode<T>> removeValue(std::shared_ptr<BinaryNode<T>> subtree_ptr, const K &target, bool &success);
 
   /** called by removeValue
       @param node_ptr a pointer to the node to be removed
@@ -115,7 +319,17 @@ private:
       @param target a reference to the item to be found
       @return a pointer to the node containing the target, nullptr if not found
      **/
-  std::shared_ptr<BinaryNode<T>> findNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, const T &target) const;
+  template <class K>
+  std::shared_ptr<BinaryNode<T>> findNode(std::shared_ptr<BinaryNode<T>> subtree_ptr, const K &target) const;
+
+  /** called by rebuildBalanced
+      @param nodes every node of the tree, in inorder
+      @param first index of the first node of the subtree in nodes
+      @param last index of the last node of the subtree in nodes
+      @post nodes[first..last] are linked into a balanced subtree
+      @return a pointer to the root of that subtree, nullptr if first > last
+     **/
+  std::shared_ptr<BinaryNode<T>> linkBalanced(const std::vector<std::shared_ptr<BinaryNode<T>>> &nodes, int first, int last);
 
   //display helpers
   void preorderHelper(std::shared_ptr<BinaryNode<T>> node);
@@ -0,0 +1,150 @@
+/**
+*@file FrozenRecipeBook.cpp
+* Implementation file for FrozenRecipeBook.
+*/
+
+#include "FrozenRecipeBook.hpp"
+
+#include <algorithm>
+
+/**
+* Default Constructor.
+* @post: Initializes an empty snapshot.
+*/
+FrozenRecipeBook::FrozenRecipeBook() : keys_(1, 0) {
+}
+
+/**
+* Parameterized Constructor.
+* @param book The RecipeBook to copy.
+* @post: The snapshot holds a copy of every Recipe in book.
+*/
+FrozenRecipeBook::FrozenRecipeBook(const RecipeBook& book) {
+    rebuild(book);
+}
+
+/**
+* Replaces the snapshot with the current contents of a RecipeBook.
+* @param book The RecipeBook to copy.
+* @post: The snapshot holds a copy of every Recipe in book. Runs in O(n).
+*/
+void FrozenRecipeBook::rebuild(const RecipeBook& book) {
+    // the book iterates in name order, so the cold array comes out sorted
+    recipes_.assign(book.begin(), book.end());
+
+    common_prefix_.clear();
+    if (!recipes_.empty()) {
+        // the prefix shared by the smallest and largest names is shared by all
+        const std::string& first = recipes_.front().name_;
+        const std::string& last = recipes_.back().name_;
+        std::size_t length = 0;
+        while (length < first.size() && length < last.size() && first[length] == last[length]) {
+            length++;
+        }
+        common_prefix_ = first.substr(0, length);
+    }
+
+    keys_.assign(recipes_.size() + 1, 0);
+    ranks_.assign(recipes_.size() + 1, 0);
+    std::uint32_t next_rank = 0;
+    placeSlot(1, next_rank);
+}
+
+/**
+* Finds a Recipe by name.
+* @param name The name of the Recipe.
+* @return: A pointer to the Recipe, or nullptr if not found.
+*/
+const Recipe* FrozenRecipeBook::findRecipe(std::string_view name) const {
+    if (recipes_.empty() || name.substr(0, common_prefix_.size()) != common_prefix_) {
+        return nullptr;
+    }
+    const std::uint64_t key = keyOf(name);
+    const std::uint64_t* keys = keys_.data();
+    const std::uint64_t count = recipes_.size();
+
+    // branch-free descent: go right while the slot's key is smaller
+    std::uint64_t slot = 1;
+    while (slot <= count) {
+        // the 16 descendants four levels down are contiguous, fetch them early;
+        // near the bottom the index is clamped to the last slot, never past it
+        __builtin_prefetch(keys + std::min<std::uint64_t>(16 * slot, count));
+        slot = 2 * slot + (keys[slot] < key);
+    }
+    // undo the trailing right turns and the last left turn: the slot left is
+    // the first key not less than key, or 0 if every key is smaller
+    slot >>= __builtin_ffsll(~slot);
+    if (slot == 0 || keys[slot] != key) {
+        // no name has these 8 bytes, no Recipe has to be read
+        return nullptr;
+    }
+
+    // names sharing the key are adjacent in the cold array from ranks_[slot] on.
+    // Usually there is one, but names with the same leading words can share it,
+    // so the run is galloped through in doubling steps and then binary searched:
+    // O(log run length) name comparisons instead of one per name in the run
+    std::size_t low = ranks_[slot];
+    std::size_t high = recipes_.size();
+    for (std::size_t step = 1; step <= high - low; step *= 2) {
+        std::size_t probe = low + step - 1;
+        if (recipes_[probe].name_ < name) {
+            low = probe + 1;
+        } else {
+            high = probe + 1;
+            break;
+        }
+    }
+    auto found = std::lower_bound(recipes_.begin() + low, recipes_.begin() + high, name, [](const Recipe& recipe, std::string_view target) {
+        return recipe.name_ < target;
+    });
+    if (found != recipes_.begin() + high && found->name_ == name) {
+        return &*found;
+    }
+    return nullptr;
+}
+
+/**
+* @return: The number of Recipes in the snapshot.
+*/
+std::size_t FrozenRecipeBook::size() const {
+    return recipes_.size();
+}
+
+/**
+* @return: True if the snapshot holds no Recipes.
+*/
+bool FrozenRecipeBook::isEmpty() const {
+    return recipes_.empty();
+}
+
+/**
+* @param name A name that starts with common_prefix_.
+* @return: The up to 8 bytes of name after common_prefix_, big-endian and zero
+padded.
+*/
+std::uint64_t FrozenRecipeBook::keyOf(std::string_view name) const {
+    std::uint64_t key = 0;
+    for (std::size_t i = 0; i < 8; i++) {
+        std::size_t index = common_prefix_.size() + i;
+        unsigned char byte = index < name.size() ? static_cast<unsigned char>(name[index]) : 0;
+        key = (key << 8) | byte;
+    }
+    return key;
+}
+
+/**
+* Fills keys_ and ranks_ by an inorder walk of the implicit tree.
+* @param slot The Eytzinger slot to fill next, with its subtrees.
+* @param next_rank The next rank in sorted order to place.
+*/
+void FrozenRecipeBook::placeSlot(std::size_t slot, std::uint32_t& next_rank) {
+    // recursion depth is log n, the implicit tree is complete
+    if (slot > recipes_.size()) {
+        return;
+    }
+    placeSlot(2 * slot, next_rank);
+    ranks_[slot] = next_rank;
+    keys_[slot] = keyOf(recipes_[next_rank].name_);
+    next_rank++;
+    placeSlot(2 * slot + 1, next_rank);
+}
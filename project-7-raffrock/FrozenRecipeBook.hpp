@@ -0,0 +1,97 @@
+/**
+*@file FrozenRecipeBook.hpp
+* Header file for FrozenRecipeBook, a read-only snapshot of a RecipeBook laid
+out for fast lookups by name.
+*/
+
+#ifndef FROZEN_RECIPEBOOK_HPP
+#define FROZEN_RECIPEBOOK_HPP
+
+#include "RecipeBook.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+* Immutable copy of a RecipeBook, for a catalog that is read far more often
+than it is written.
+* Lookups never touch a Recipe until the last step. They search a contiguous
+array of 8-byte keys stored in Eytzinger (BFS) order: the children of slot k
+are slots 2k and 2k+1, so the top levels share a few cache lines, the slots
+a few levels down can be prefetched, and each step is a comparison feeding an
+index instead of a branch. The Recipes themselves sit in a separate cold
+array in name order.
+* Writes go to the RecipeBook; call rebuild to pick them up.
+*/
+class FrozenRecipeBook {
+
+public:
+    /**
+    * Default Constructor.
+    * @post: Initializes an empty snapshot.
+    */
+    FrozenRecipeBook();
+
+    /**
+    * Parameterized Constructor.
+    * @param book The RecipeBook to copy.
+    * @post: The snapshot holds a copy of every Recipe in book.
+    */
+    explicit FrozenRecipeBook(const RecipeBook& book);
+
+    /**
+    * Replaces the snapshot with the current contents of a RecipeBook.
+    * @param book The RecipeBook to copy.
+    * @post: The snapshot holds a copy of every Recipe in book; pointers
+    returned by earlier findRecipe calls are invalidated. Runs in O(n).
+    */
+    void rebuild(const RecipeBook& book);
+
+    /**
+    * Finds a Recipe by name.
+    * @param name The name of the Recipe.
+    * @return: A pointer to the Recipe, or nullptr if not found. It stays valid
+    until the next rebuild.
+    */
+    const Recipe* findRecipe(std::string_view name) const;
+
+    /**
+    * @return: The number of Recipes in the snapshot.
+    */
+    std::size_t size() const;
+
+    /**
+    * @return: True if the snapshot holds no Recipes.
+    */
+    bool isEmpty() const;
+
+private:
+    // keys_[k] is the key of recipes_[ranks_[k]], for k in 1..size();
+    // keys_[0] is unused so the children of k are 2k and 2k+1
+    std::vector<std::uint64_t> keys_;
+    std::vector<std::uint32_t> ranks_;
+    // cold payloads, sorted by name
+    std::vector<Recipe> recipes_;
+    // every name starts with this; keys are taken from the bytes after it
+    std::string common_prefix_;
+
+    /**
+    * @param name A name that starts with common_prefix_.
+    * @return: The up to 8 bytes of name after common_prefix_, big-endian and
+    zero padded, so keys compare in the same order as the names.
+    */
+    std::uint64_t keyOf(std::string_view name) const;
+
+    /**
+    * Fills keys_ and ranks_ from recipes_ by an inorder walk of the implicit
+    tree, so the sorted ranks land in BFS order.
+    * @param slot The Eytzinger slot to fill next, with its subtrees.
+    * @param next_rank The next rank in sorted order to place.
+    */
+    void placeSlot(std::size_t slot, std::uint32_t& next_rank);
+};
+
+#endif
@@ -0,0 +1,73 @@
+/** @file NodeArena.cpp */
+
+#include "NodeArena.hpp"
+
+template <class T>
+NodeArena<T>::NodeArena() : free_head_(NULL_INDEX), live_count_(0)
+{
+} // end default constructor
+
+template <class T>
+std::uint32_t NodeArena<T>::allocate(const T &an_item)
+{
+  std::uint32_t index;
+  if (free_head_ != NULL_INDEX)
+  {
+    // Reuse a released slot
+    index = free_head_;
+    free_head_ = slots_[index].left;
+    slots_[index].item = an_item;
+  }
+  else
+  {
+    index = static_cast<std::uint32_t>(slots_.size());
+    slots_.push_back(Slot{an_item, NULL_INDEX, NULL_INDEX, 1});
+  }
+  slots_[index].left = NULL_INDEX;
+  slots_[index].right = NULL_INDEX;
+  slots_[index].height = 1;
+  live_count_++;
+  return index;
+} // end allocate
+
+template <class T>
+void NodeArena<T>::release(std::uint32_t index)
+{
+  slots_[index].item = T();
+  slots_[index].right = NULL_INDEX;
+  slots_[index].left = free_head_;
+  free_head_ = index;
+  live_count_--;
+} // end release
+
+template <class T>
+void NodeArena<T>::clear()
+{
+  slots_.clear();
+  free_head_ = NULL_INDEX;
+  live_count_ = 0;
+} // end clear
+
+template <class T>
+void NodeArena<T>::reserve(std::size_t count)
+{
+  slots_.reserve(count);
+} // end reserve
+
+template <class T>
+std::size_t NodeArena<T>::size() const
+{
+  return live_count_;
+} // end size
+
+template <class T>
+typename NodeArena<T>::Slot &NodeArena<T>::operator[](std::uint32_t index)
+{
+  return slots_[index];
+} // end operator[]
+
+template <class T>
+const typename NodeArena<T>::Slot &NodeArena<T>::operator[](std::uint32_t index) const
+{
+  return slots_[index];
+} // end operator[]
@@ -0,0 +1,59 @@
+/** A contiguous pool of binary tree nodes linked by 32-bit indices.
+ Nodes live in one std::vector instead of one heap allocation each, so a walk
+ down the tree touches packed memory and copies no reference counts.
+ Released slots are kept on a free list and reused by the next allocate.
+ @file NodeArena.hpp */
+
+#ifndef NODE_ARENA_
+#define NODE_ARENA_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template <class T>
+class NodeArena
+{
+public:
+  /** index used for "no child" and "no node" **/
+  static constexpr std::uint32_t NULL_INDEX = 0xFFFFFFFFu;
+
+  struct Slot
+  {
+    T item;
+    std::uint32_t left;   // index of the left child, NULL_INDEX if none
+    std::uint32_t right;  // index of the right child, NULL_INDEX if none
+    std::int32_t height;  // height of the subtree rooted here
+  };
+
+  NodeArena();
+
+  /** @param an_item the item to store
+      @return the index of a leaf slot holding a copy of an_item **/
+  std::uint32_t allocate(const T &an_item);
+
+  /** @param index a slot returned by allocate and not yet released
+      @post the slot is put on the free list and its item is reset to T() **/
+  void release(std::uint32_t index);
+
+  /** @post every slot is released at once, capacity is kept for reuse **/
+  void clear();
+
+  /** @post room for count slots is allocated up front **/
+  void reserve(std::size_t count);
+
+  /** @return the number of slots in use **/
+  std::size_t size() const;
+
+  /** @return the slot at index. References are invalidated by allocate. **/
+  Slot &operator[](std::uint32_t index);
+  const Slot &operator[](std::uint32_t index) const;
+
+private:
+  std::vector<Slot> slots_;
+  std::uint32_t free_head_;  // first released slot, chained through Slot::left
+  std::size_t live_count_;
+};
+
+#include "NodeArena.cpp"
+#endif
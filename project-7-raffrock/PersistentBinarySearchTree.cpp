@@ -0,0 +1,426 @@
+/** @file PersistentBinarySearchTree.cpp */
+
+#include "PersistentBinarySearchTree.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+
+/*SNAPSHOT*/
+
+template <class T>
+PersistentBinarySearchTree<T>::Snapshot::Snapshot(const Snapshot &other)
+    : registry_(other.registry_), version_(other.version_)
+{
+  // other holds the version, so it cannot be reclaimed under this increment
+  if (version_ != nullptr)
+    version_->state.fetch_add(1, std::memory_order_relaxed);
+} // end copy constructor
+
+template <class T>
+PersistentBinarySearchTree<T>::Snapshot::Snapshot(Snapshot &&other) noexcept
+    : registry_(std::move(other.registry_)), version_(other.version_)
+{
+  other.version_ = nullptr;
+} // end move constructor
+
+template <class T>
+typename PersistentBinarySearchTree<T>::Snapshot &PersistentBinarySearchTree<T>::Snapshot::operator=(Snapshot other) noexcept
+{
+  // other releases what this Snapshot held when it goes out of scope
+  std::swap(registry_, other.registry_);
+  std::swap(version_, other.version_);
+  return *this;
+} // end operator=
+
+template <class T>
+PersistentBinarySearchTree<T>::Snapshot::~Snapshot()
+{
+  // Release: every read of the version comes before the writer reclaims it
+  if (version_ != nullptr)
+    version_->state.fetch_sub(1, std::memory_order_release);
+} // end destructor
+
+template <class T>
+bool PersistentBinarySearchTree<T>::Snapshot::isEmpty() const
+{
+  return version_ == nullptr || version_->root_ptr == nullptr;
+} // end isEmpty
+
+template <class T>
+int PersistentBinarySearchTree<T>::Snapshot::getHeight() const
+{
+  return version_ == nullptr ? 0 : heightOf(version_->root_ptr);
+} // end getHeight
+
+template <class T>
+int PersistentBinarySearchTree<T>::Snapshot::getNumberOfNodes() const
+{
+  return version_ == nullptr ? 0 : version_->node_count;
+} // end getNumberOfNodes
+
+template <class T>
+bool PersistentBinarySearchTree<T>::Snapshot::contains(const T &entry) const
+{
+  return find(entry) != nullptr;
+} // end contains
+
+template <class T>
+template <class K>
+const T *PersistentBinarySearchTree<T>::Snapshot::find(const K &key) const
+{
+  if (version_ == nullptr)
+    return nullptr;
+  // No lock: nothing reachable from a published root is ever modified
+  const BinaryNode<T> *current = version_->root_ptr.get();
+  while (current != nullptr)
+  {
+    const T &item = current->item();
+    if (item == key)
+      return &item; // Found
+    else if (item > key)
+      current = current->getLeftChildPtr().get(); // Search left subtree
+    else
+      current = current->getRightChildPtr().get(); // Search right subtree
+  }
+  return nullptr; // Not found
+} // end find
+
+
+
+/*CONSTRUCTORS*/
+
+template <class T>
+PersistentBinarySearchTree<T>::PersistentBinarySearchTree()
+    : registry_(std::make_shared<Registry>())
+{
+  publish(nullptr, 0);
+} // end default constructor
+
+template <class T>
+PersistentBinarySearchTree<T>::PersistentBinarySearchTree(const PersistentBinarySearchTree &other)
+    : registry_(std::make_shared<Registry>())
+{
+  // Published nodes are never changed, so sharing other's root is a full copy
+  Snapshot source = other.snapshot();
+  publish(source.version_->root_ptr, source.version_->node_count);
+} // end copy constructor
+
+template <class T>
+PersistentBinarySearchTree<T> &PersistentBinarySearchTree<T>::operator=(const PersistentBinarySearchTree &other)
+{
+  // Taken first: other may be this tree, whose mutex is taken below
+  Snapshot source = other.snapshot();
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  publish(source.version_->root_ptr, source.version_->node_count);
+  return *this;
+} // end operator=
+
+
+
+/*PUBLIC METHODS*/
+
+template <class T>
+typename PersistentBinarySearchTree<T>::Snapshot PersistentBinarySearchTree<T>::snapshot() const
+{
+  Snapshot current;
+  current.registry_ = registry_;
+  current.version_ = acquire(*registry_);
+  return current;
+} // end snapshot
+
+template <class T>
+void PersistentBinarySearchTree<T>::add(const T &new_entry)
+{
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  const Version &current = latest();
+  publish(insertPath(current.root_ptr, new_entry), current.node_count + 1);
+} // end add
+
+template <class T>
+bool PersistentBinarySearchTree<T>::remove(const T &entry)
+{
+  return removeKey(entry);
+} // end remove
+
+template <class T>
+template <class K>
+bool PersistentBinarySearchTree<T>::removeKey(const K &key)
+{
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  const Version &current = latest();
+  bool is_successful = false;
+  NodePtr new_root_ptr = removePath(current.root_ptr, key, is_successful);
+  if (is_successful)
+    publish(std::move(new_root_ptr), current.node_count - 1);
+  return is_successful;
+} // end removeKey
+
+template <class T>
+bool PersistentBinarySearchTree<T>::replace(const T &entry)
+{
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  const Version &current = latest();
+  bool is_successful = false;
+  NodePtr new_root_ptr = replacePath(current.root_ptr, entry, is_successful);
+  if (is_successful)
+    publish(std::move(new_root_ptr), current.node_count);
+  return is_successful;
+} // end replace
+
+template <class T>
+template <class RandomIt>
+void PersistentBinarySearchTree<T>::buildFromSorted(RandomIt first, RandomIt last)
+{
+  int count = static_cast<int>(last - first);
+  // Built before taking the lock, readers and other writers never wait on it
+  NodePtr new_root_ptr = buildBalanced(first, count);
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  publish(std::move(new_root_ptr), count);
+} // end buildFromSorted
+
+template <class T>
+void PersistentBinarySearchTree<T>::clear()
+{
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  publish(nullptr, 0);
+} // end clear
+
+template <class T>
+int PersistentBinarySearchTree<T>::getNumberOfNodes() const
+{
+  return snapshot().getNumberOfNodes();
+} // end getNumberOfNodes
+
+template <class T>
+bool PersistentBinarySearchTree<T>::contains(const T &entry) const
+{
+  return snapshot().contains(entry);
+} // end contains
+
+
+
+/*PRIVATE METHODS*/
+
+template <class T>
+void PersistentBinarySearchTree<T>::publish(NodePtr root_ptr, int node_count)
+{
+  Registry &registry = *registry_;
+  // The only step that can throw, so a failed publish changes nothing
+  Version *version = unusedVersion();
+  registry.unused.pop_back();
+  version->root_ptr = std::move(root_ptr);
+  version->node_count = node_count;
+  // Release: a reader that counts itself in sees the root and the count above
+  version->state.store(0, std::memory_order_release);
+  Version *replaced = registry.current.load(std::memory_order_relaxed);
+  registry.current.store(version, std::memory_order_release);
+  if (replaced != nullptr)
+    registry.retired.push_back(replaced); // capacity reserved by unusedVersion
+
+  // A retired version no Snapshot holds is marked DEAD, which readers never
+  // count into, and only then are its nodes freed
+  std::size_t kept = 0;
+  for (Version *retired : registry.retired)
+  {
+    std::uint32_t idle = 0;
+    if (retired->state.compare_exchange_strong(idle, DEAD, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      retired->root_ptr = nullptr;
+      registry.unused.push_back(retired); // capacity reserved by unusedVersion
+    }
+    else
+      registry.retired[kept++] = retired;
+  }
+  registry.retired.resize(kept);
+} // end publish
+
+template <class T>
+typename PersistentBinarySearchTree<T>::Version *PersistentBinarySearchTree<T>::unusedVersion()
+{
+  Registry &registry = *registry_;
+  if (registry.unused.empty())
+  {
+    // Every Version is at most once in each list, so with room for all of
+    // them neither list grows while publishing
+    std::size_t count = registry.versions.size() + 1;
+    registry.versions.reserve(count);
+    registry.retired.reserve(count);
+    registry.unused.reserve(count);
+    registry.versions.push_back(std::make_unique<Version>());
+    registry.unused.push_back(registry.versions.back().get());
+  }
+  return registry.unused.back();
+} // end unusedVersion
+
+template <class T>
+typename PersistentBinarySearchTree<T>::Version *PersistentBinarySearchTree<T>::acquire(Registry &registry)
+{
+  while (true)
+  {
+    // Versions are never freed before the registry, so this one can be looked at
+    // even if the writer has replaced and reclaimed it since
+    Version *version = registry.current.load(std::memory_order_acquire);
+    std::uint32_t state = version->state.load(std::memory_order_relaxed);
+    if ((state & DEAD) != 0)
+      continue; // Reclaimed: current has moved on
+    if (!version->state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+      continue;
+    // Counted in, so it cannot be reclaimed anymore. A pooled version is counted
+    // before it is stored as current, so it is only kept if it is current now
+    if (registry.current.load(std::memory_order_acquire) == version)
+      return version;
+    version->state.fetch_sub(1, std::memory_order_release);
+  }
+} // end acquire
+
+template <class T>
+const typename PersistentBinarySearchTree<T>::Version &PersistentBinarySearchTree<T>::latest() const
+{
+  // Only writers store current, and they hold the mutex, so it stays put
+  return *registry_->current.load(std::memory_order_relaxed);
+} // end latest
+
+template <class T>
+int PersistentBinarySearchTree<T>::heightOf(const NodePtr &subtree_ptr)
+{
+  return subtree_ptr == nullptr ? 0 : subtree_ptr->getHeight();
+} // end heightOf
+
+template <class T>
+typename PersistentBinarySearchTree<T>::NodePtr PersistentBinarySearchTree<T>::makeNode(const T &item, NodePtr left_ptr, NodePtr right_ptr)
+{
+  int height = 1 + std::max(heightOf(left_ptr), heightOf(right_ptr));
+  NodePtr node_ptr = std::make_shared<BinaryNode<T>>(item, std::move(left_ptr), std::move(right_ptr));
+  node_ptr->setHeight(height);
+  return node_ptr;
+} // end makeNode
+
+template <class T>
+typename PersistentBinarySearchTree<T>::NodePtr PersistentBinarySearchTree<T>::makeBalanced(const T &item, NodePtr left_ptr, NodePtr right_ptr)
+{
+  int left_height = heightOf(left_ptr);
+  int right_height = heightOf(right_ptr);
+
+  if (left_height > right_height + 1)
+  {
+    // Left heavy: the rotations rebuild the nodes they move instead of relinking them
+    const NodePtr &left_left = left_ptr->getLeftChildPtr();
+    const NodePtr &left_right = left_ptr->getRightChildPtr();
+    if (heightOf(left_left) >= heightOf(left_right))
+      // Single right rotation
+      return makeNode(left_ptr->item(), left_left, makeNode(item, left_right, std::move(right_ptr)));
+    // Left-right double rotation
+    return makeNode(left_right->item(),
+                    makeNode(left_ptr->item(), left_left, left_right->getLeftChildPtr()),
+                    makeNode(item, left_right->getRightChildPtr(), std::move(right_ptr)));
+  }
+  if (right_height > left_height + 1)
+  {
+    // Right heavy, mirror image of the case above
+    const NodePtr &right_left = right_ptr->getLeftChildPtr();
+    const NodePtr &right_right = right_ptr->getRightChildPtr();
+    if (heightOf(right_right) >= heightOf(right_left))
+      // Single left rotation
+      return makeNode(right_ptr->item(), makeNode(item, std::move(left_ptr), right_left), right_right);
+    // Right-left double rotation
+    return makeNode(right_left->item(),
+                    makeNode(item, std::move(left_ptr), right_left->getLeftChildPtr()),
+                    makeNode(right_ptr->item(), right_left->getRightChildPtr(), right_right));
+  }
+  return makeNode(item, std::move(left_ptr), std::move(right_ptr));
+} // end makeBalanced
+
+template <class T>
+typename PersistentBinarySearchTree<T>::NodePtr PersistentBinarySearchTree<T>::insertPath(const NodePtr &subtree_ptr, const T &new_entry)
+{
+  if (subtree_ptr == nullptr)
+    return makeNode(new_entry, nullptr, nullptr);
+  if (subtree_ptr->item() > new_entry)
+    return makeBalanced(subtree_ptr->item(), insertPath(subtree_ptr->getLeftChildPtr(), new_entry), subtree_ptr->getRightChildPtr());
+  return makeBalanced(subtree_ptr->item(), subtree_ptr->getLeftChildPtr(), insertPath(subtree_ptr->getRightChildPtr(), new_entry));
+} // end insertPath
+
+template <class T>
+template <class K>
+typename PersistentBinarySearchTree<T>::NodePtr PersistentBinarySearchTree<T>::removePath(const NodePtr &subtree_ptr, const K &target, bool &success)
+{
+  if (subtree_ptr == nullptr)
+  {
+    // Not found, nothing is copied on the way back up
+    success = false;
+    return subtree_ptr;
+  }
+
+  const NodePtr &left_ptr = subtree_ptr->getLeftChildPtr();
+  const NodePtr &right_ptr = subtree_ptr->getRightChildPtr();
+  if (subtree_ptr->item() == target)
+  {
+    success = true;
+    if (left_ptr == nullptr)
+      return right_ptr;
+    if (right_ptr == nullptr)
+      return left_ptr;
+    // Two children: the inorder successor takes this node's place
+    T successor;
+    NodePtr new_right_ptr = removeMinPath(right_ptr, successor);
+    return makeBalanced(successor, left_ptr, std::move(new_right_ptr));
+  }
+
+  if (subtree_ptr->item() > target)
+  {
+    NodePtr new_left_ptr = removePath(left_ptr, target, success);
+    return success ? makeBalanced(subtree_ptr->item(), std::move(new_left_ptr), right_ptr) : subtree_ptr;
+  }
+  NodePtr new_right_ptr = removePath(right_ptr, target, success);
+  return success ? makeBalanced(subtree_ptr->item(), left_ptr, std::move(new_right_ptr)) : subtree_ptr;
+} // end removePath
+
+template <class T>
+typename PersistentBinarySearchTree<T>::NodePtr PersistentBinarySearchTree<T>::removeMinPath(const NodePtr &subtree_ptr, T &smallest)
+{
+  if (subtree_ptr->getLeftChildPtr() == nullptr)
+  {
+    smallest = subtree_ptr->item();
+    return subtree_ptr->getRightChildPtr();
+  }
+  return makeBalanced(subtree_ptr->item(), removeMinPath(subtree_ptr->getLeftChildPtr(), smallest), subtree_ptr->getRightChildPtr());
+} // end removeMinPath
+
+template <class T>
+typename PersistentBinarySearchTree<T>::NodePtr PersistentBinarySearchTree<T>::replacePath(const NodePtr &subtree_ptr, const T &entry, bool &success)
+{
+  if (subtree_ptr == nullptr)
+  {
+    success = false;
+    return subtree_ptr;
+  }
+
+  const NodePtr &left_ptr = subtree_ptr->getLeftChildPtr();
+  const NodePtr &right_ptr = subtree_ptr->getRightChildPtr();
+  if (subtree_ptr->item() == entry)
+  {
+    // Same key, same place in the order: the shape and the heights are unchanged
+    success = true;
+    return makeNode(entry, left_ptr, right_ptr);
+  }
+  if (subtree_ptr->item() > entry)
+  {
+    NodePtr new_left_ptr = replacePath(left_ptr, entry, success);
+    return success ? makeNode(subtree_ptr->item(), std::move(new_left_ptr), right_ptr) : subtree_ptr;
+  }
+  NodePtr new_right_ptr = replacePath(right_ptr, entry, success);
+  return success ? makeNode(subtree_ptr->item(), left_ptr, std::move(new_right_ptr)) : subtree_ptr;
+} // end replacePath
+
+template <class T>
+template <class RandomIt>
+typename PersistentBinarySearchTree<T>::NodePtr PersistentBinarySearchTree<T>::buildBalanced(RandomIt first, int count)
+{
+  if (count == 0)
+    return nullptr;
+  // The middle item is the root, so the two halves differ in size by at most one
+  int mid = (count - 1) / 2;
+  return makeNode(first[mid], buildBalanced(first, mid), buildBalanced(first + mid + 1, count - mid - 1));
+} // end buildBalanced
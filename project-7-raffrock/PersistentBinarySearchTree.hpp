@@ -0,0 +1,207 @@
+/** Persistent (path-copying) AVL tree for many reader threads and one writer at a time.
+ add and remove never change a published node: they copy the nodes on the
+ root-to-leaf path, share every other subtree with the previous version, and
+ publish the new version by storing one atomic pointer to it. Taking a Snapshot
+ is lock-free: the reader loads that pointer and counts itself into the version
+ with a compare-and-swap, retried only when a writer replaced the version in
+ between, and then searches it without any lock while writers keep going.
+ Versions are pooled and never freed while the tree or a Snapshot of it lives,
+ so a reader can always look at the one it loaded. A replaced version is
+ reclaimed, and its nodes freed, by the first publish after its last Snapshot
+ goes away.
+ @file PersistentBinarySearchTree.hpp */
+
+#ifndef PERSISTENT_BINARY_SEARCH_TREE_
+#define PERSISTENT_BINARY_SEARCH_TREE_
+
+#include "BinaryNode.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+template <class T>
+class PersistentBinarySearchTree
+{
+  struct Version;
+  struct Registry;
+
+public:
+  /** A consistent, immutable view of the tree as of one publish. Cheap to copy. **/
+  class Snapshot
+  {
+  public:
+    Snapshot() = default;
+    Snapshot(const Snapshot &other);
+    Snapshot(Snapshot &&other) noexcept;
+    Snapshot &operator=(Snapshot other) noexcept;
+    ~Snapshot();
+
+    /** @return true if this version of the tree is empty **/
+    bool isEmpty() const;
+
+    /** @return the height of this version as the number of nodes on the longest path from root to leaf**/
+    int getHeight() const;
+
+    /** @return the number of nodes in this version**/
+    int getNumberOfNodes() const;
+
+    /** @param entry to be found
+        @return true if entry is in this version**/
+    bool contains(const T &entry) const;
+
+    /** Heterogeneous lookup, see BinarySearchTree::find.
+        @param key the key to be found
+        @return a pointer to the item equal to key, nullptr if not found.
+                It stays valid as long as this Snapshot (or a copy of it) lives.**/
+    template <class K>
+    const T *find(const K &key) const;
+
+  private:
+    friend class PersistentBinarySearchTree;
+    // keeps the pool, and so version_, allocated even if the tree goes away
+    std::shared_ptr<Registry> registry_;
+    // counted in version_->state while held, nullptr for an empty Snapshot
+    Version *version_ = nullptr;
+  };
+
+  /*Constructors*/
+  PersistentBinarySearchTree(); //default constructor
+
+  /** @post this tree starts from the latest version of other and shares all of its
+            nodes, in O(1); from there the two diverge, each with its own writer mutex**/
+  PersistentBinarySearchTree(const PersistentBinarySearchTree &other);
+  PersistentBinarySearchTree &operator=(const PersistentBinarySearchTree &other);
+
+  /** Safe to call from any thread. Lock-free: it never takes the writer mutex,
+      and only retries when a writer publishes while it runs.
+      @return the latest published version**/
+  Snapshot snapshot() const;
+
+  /** @param new_entry a new entry to be added
+      @post a new version holding new_entry is published; O(log n) nodes are copied,
+            the rest are shared with the previous version. Writers are serialized.**/
+  void add(const T &new_entry);
+
+  /** @param entry to be removed
+      @post if entry was found, a new version without it is published
+      @return true if entry was removed, false otherwise**/
+  bool remove(const T &entry);
+
+  /** @param key the key of the entry to be removed
+      @return true if an entry was removed, false otherwise**/
+  template <class K>
+  bool removeKey(const K &key);
+
+  /** @param entry the new value of the item equal to it
+      @post if such an item was found, a new version holding entry in its place is
+            published; only the path to it is copied and nothing is rebalanced
+      @return true if an item was replaced, false otherwise**/
+  bool replace(const T &entry);
+
+  /** @param first, last a random access range of items sorted ascending, without duplicates
+      @post a new version holding exactly those items, perfectly balanced, is published.
+            Runs in O(n), items are not compared.**/
+  template <class RandomIt>
+  void buildFromSorted(RandomIt first, RandomIt last);
+
+  /** @post an empty version is published; the nodes are freed with the last Snapshot
+            still holding them**/
+  void clear();
+
+  /** @return the number of nodes in the latest version**/
+  int getNumberOfNodes() const;
+
+  /** @param entry to be found
+      @return true if entry is in the latest version**/
+  bool contains(const T &entry) const;
+
+private:
+  using NodePtr = std::shared_ptr<BinaryNode<T>>;
+
+  /** what gets published: a root and its node count, never changed while it is
+      published or held by a Snapshot **/
+  struct Version
+  {
+    NodePtr root_ptr;
+    int node_count = 0;
+    // the number of Snapshots holding this version, or DEAD once the writer has
+    // reclaimed it; readers only ever add to a count that is not DEAD
+    std::atomic<std::uint32_t> state{0};
+  };
+
+  static constexpr std::uint32_t DEAD = std::uint32_t(1) << 31;
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Snapshots must be lock-free");
+  static_assert(std::atomic<Version *>::is_always_lock_free, "Snapshots must be lock-free");
+
+  /** every Version of one tree; shared with the Snapshots so they can outlive it **/
+  struct Registry
+  {
+    // the latest published version, stored only by the writer
+    std::atomic<Version *> current{nullptr};
+    // the rest is the writer's, under writer_mutex_
+    std::vector<std::unique_ptr<Version>> versions;
+    std::vector<Version *> retired; // replaced, maybe still held by a Snapshot
+    std::vector<Version *> unused;  // reclaimed or new, ready to be published
+  };
+
+  std::shared_ptr<Registry> registry_;
+  std::mutex writer_mutex_;
+
+  /** @post a new version is published with one atomic store, and the replaced
+            versions no Snapshot holds anymore are reclaimed **/
+  void publish(NodePtr root_ptr, int node_count);
+
+  /** @return the Version the next publish takes from unused, made if there is none **/
+  Version *unusedVersion();
+
+  /** @return the current version of registry, counted for the caller **/
+  static Version *acquire(Registry &registry);
+
+  /** @return the version the writer works from **/
+  const Version &latest() const;
+
+  // Functional AVL helpers: they build new nodes and never modify an existing one.
+  // Recursion depth is the AVL height, about 1.44 log n.
+
+  /** @return the height of subtree_ptr, 0 if nullptr **/
+  static int heightOf(const NodePtr &subtree_ptr);
+
+  /** @return a new node holding item over the given children, with its height set **/
+  static NodePtr makeNode(const T &item, NodePtr left_ptr, NodePtr right_ptr);
+
+  /** @return a new subtree holding item over the given children, rotated (by copying)
+              if their heights differ by two**/
+  static NodePtr makeBalanced(const T &item, NodePtr left_ptr, NodePtr right_ptr);
+
+  /** called by add
+      @return the root of a new version of subtree_ptr that also holds new_entry**/
+  static NodePtr insertPath(const NodePtr &subtree_ptr, const T &new_entry);
+
+  /** called by remove and removeKey
+      @return the root of a new version of subtree_ptr without target;
+              subtree_ptr itself if target was not found**/
+  template <class K>
+  static NodePtr removePath(const NodePtr &subtree_ptr, const K &target, bool &success);
+
+  /** called by removePath
+      @param smallest set to the smallest item of subtree_ptr
+      @return the root of a new version of subtree_ptr without its smallest item**/
+  static NodePtr removeMinPath(const NodePtr &subtree_ptr, T &smallest);
+
+  /** called by replace
+      @return the root of a new version of subtree_ptr with entry in place of the item
+              equal to it; subtree_ptr itself if there is none**/
+  static NodePtr replacePath(const NodePtr &subtree_ptr, const T &entry, bool &success);
+
+  /** called by buildFromSorted
+      @param first the first item of the subtree
+      @param count the number of items of the subtree
+      @return the root of a balanced subtree holding first[0..count), nullptr if count is 0**/
+  template <class RandomIt>
+  static NodePtr buildBalanced(RandomIt first, int count);
+};
+
+#include "PersistentBinarySearchTree.cpp"
+#endif
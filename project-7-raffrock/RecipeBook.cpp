@@ -1,17 +1,26 @@
 /** 
-*@file StationManager.cpp 
+*@file RecipeBook.cpp 
 * Rafael Chetata
 * 12/16/24
-* Implementation file for RecipeBook class. This file contains the code for all class functions.
+* Implementation file for BasicRecipeBook<Container>. Both of its aliases,
+RecipeBook and BTreeRecipeBook, are compiled here once.
 */
 
 #include "RecipeBook.hpp"
+#include "RecipeWriter.hpp"
+#include "RecipeSnapshot.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
 
 /**
 * Default Constructor.
 * @post: Initializes an empty RecipeBook.
 */
-RecipeBook::RecipeBook() {
+template <class Container>
+BasicRecipeBook<Container>::BasicRecipeBook()
+    : difficulty_indexed_(false), descriptions_indexed_(false), names_indexed_(false), publishing_(false) {
 }
 
 /**
@@ -24,9 +33,74 @@ CSV file.
 * Ignore the first line. Each subsequent line represents a Recipe to be
 added to the RecipeBook.
 */
-RecipeBook::RecipeBook(const std::string& filename) {
+template <class Container>
+BasicRecipeBook<Container>::BasicRecipeBook(const std::string& filename)
+    : difficulty_indexed_(false), descriptions_indexed_(false), names_indexed_(false), publishing_(false) {
+    loadRecipes(filename);
+}
+
+/**
+* Splits the next comma separated field off a CSV line.
+* @param line The line being read.
+* @param pos The index where the field starts; moved past the field's comma.
+* @return A view of the field, empty if the line has no more fields.
+*/
+static std::string_view nextField(const std::string& line, std::size_t& pos) {
+    if (pos > line.size()) {
+        return std::string_view();
+    }
+    std::size_t comma = line.find(',', pos);
+    if (comma == std::string::npos) {
+        comma = line.size();
+    }
+    std::string_view field(line.data() + pos, comma - pos);
+    pos = comma + 1;
+    return field;
+}
+
+/**
+* Parses an integer CSV field, as std::stoi would but without copying it.
+* @param field The field, optionally surrounded by spaces.
+* @return The integer the field starts with.
+* @throws std::invalid_argument If the field does not start with one.
+* @throws std::out_of_range If it does not fit in an int.
+*/
+static int parseInt(std::string_view field) {
+    std::size_t first = 0;
+    while (first < field.size() && std::isspace(static_cast<unsigned char>(field[first]))) {
+        first++;
+    }
+    // from_chars takes a '-' but not a '+'
+    if (first + 1 < field.size() && field[first] == '+' && field[first + 1] != '-') {
+        first++;
+    }
+    int value = 0;
+    std::from_chars_result result = std::from_chars(field.data() + first, field.data() + field.size(), value);
+    if (result.ec == std::errc::invalid_argument) {
+        throw std::invalid_argument("parseInt");
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("parseInt");
+    }
+    return value;
+}
+
+/**
+* Loads Recipes from a CSV file.
+* @param filename A const reference to a string representing the name of a
+CSV file, in the format described for the parameterized constructor.
+* @post: Every Recipe whose name is not already in the book, and not repeated
+earlier in the file, is added. Into an empty book, all rows are parsed first,
+sorted and deduplicated by name, and the tree is built balanced in one O(n)
+pass instead of one addRecipe per row.
+* @return: The names that were skipped because a Recipe with the same name was
+already in the book or earlier in the file, once per skipped row.
+*/
+template <class Container>
+std::vector<std::string> BasicRecipeBook<Container>::loadRecipes(const std::string& filename) {
     // open file based on name in parameter
     std::ifstream recipe_file(filename);
+    std::vector<Recipe> recipes;
 
     // stores string that contains all recipe information
     // ex. name,difficulty_level,description,mastered
@@ -34,67 +108,123 @@ RecipeBook::RecipeBook(const std::string& filename) {
     // skip first line of information
     std::getline(recipe_file,recipe_line);
 
-    if (recipe_file.is_open()) {
-        while (std::getline(recipe_file,recipe_line)) {
-            // turns line into stream to get information from
-            std::istringstream r_stream(recipe_line);
-            // hold individual pieces of information
-            std::string r_word;
-            // empty Recipe object to assign values from on r_stream
-            Recipe placeholder_recipe;
-
-            // asigning values to placeholder_recipe
-            std::getline(r_stream, r_word, ',');
-            placeholder_recipe.name_ = r_word;
-            std::getline(r_stream, r_word, ',');
-            placeholder_recipe.difficulty_level_ = std::stoi(r_word);
-            std::getline(r_stream, r_word, ',');
-            placeholder_recipe.description_ = r_word;
-            std::getline(r_stream, r_word, ',');
-            placeholder_recipe.mastered_ = std::stoi(r_word); // 0 or 1
-
-            // add recipe to tree
-            addRecipe(placeholder_recipe);
-        }
+    while (std::getline(recipe_file,recipe_line)) {
+        std::size_t pos = 0;
+        Recipe& recipe = recipes.emplace_back();
+        recipe.name_ = nextField(recipe_line, pos);
+        recipe.difficulty_level_ = parseInt(nextField(recipe_line, pos));
+        recipe.description_ = nextField(recipe_line, pos);
+        recipe.mastered_ = parseInt(nextField(recipe_line, pos)); // 0 or 1
     }
-
     recipe_file.close();
+
+    return addRecipes(std::move(recipes));
 }
 
 /**
-* Finds a Recipe in the tree by name.
-* @param name A const reference to the name.
-* @return A pointer to the node containing the Recipe with the given
-difficulty level, or nullptr if not found.
-*/
-std::shared_ptr<BinaryNode<Recipe>> RecipeBook::findRecipe(const std::string& name) {
-    // using stack to hold the nodes
-    std::stack<std::shared_ptr<BinaryNode<Recipe>>> node_stack; 
-    // start with root node
-    node_stack.push(getRoot());
-
-    while (!node_stack.empty() && node_stack.top() != nullptr) {
-        // get node at top of stack
-        std::shared_ptr<BinaryNode<Recipe>> current_node_ptr = node_stack.top();
-        node_stack.pop();
-
-        // check if current node is the recipe 
-        if (current_node_ptr->getItem().name_ == name) {
-            // return if is recipe
-            return current_node_ptr;
-        }
+* Loads a snapshot file written by RecipeSnapshot::write.
+* @param filename The snapshot file.
+* @post: If the file is a valid snapshot, the book holds exactly its Recipes;
+otherwise the book is left unchanged.
+* @return: True if the file was loaded.
+*/
+template <class Container>
+bool BasicRecipeBook<Container>::loadSnapshot(const std::string& filename) {
+    // open checks both orders, so everything below can trust them
+    RecipeSnapshot snapshot;
+    if (!snapshot.open(filename)) {
+        return false;
+    }
+    clear();
 
-        // append left and right nodes to stack if they exist
-        if (current_node_ptr->getLeftChildPtr() != nullptr) {
-            node_stack.push(current_node_ptr->getLeftChildPtr());
+    // only the tree is built, straight from the name order: the indexes are
+    // built on first use, as after any other load
+    std::vector<Recipe> recipes;
+    recipes.reserve(snapshot.size());
+    for (std::uint32_t index : snapshot.nameOrder()) {
+        RecipeView view = snapshot.at(index);
+        recipes.emplace_back(std::string(view.name_), view.difficulty_level_, std::string(view.description_), view.mastered_);
+    }
+    Container::buildFromSorted(std::make_move_iterator(recipes.begin()), std::make_move_iterator(recipes.end()));
+    publishAll();
+    return true;
+}
+
+/**
+* Adds many Recipes at once.
+* @param recipes The Recipes to add, in any order.
+* @post: Every Recipe whose name is not already in the book, and not repeated
+earlier in recipes, is added. Into an empty book, the tree and its indexes
+are built balanced in one O(n) pass after sorting.
+* @return: The names that were skipped, once per skipped Recipe.
+*/
+template <class Container>
+std::vector<std::string> BasicRecipeBook<Container>::addRecipes(std::vector<Recipe> recipes) {
+    std::vector<std::string> duplicate_names;
+
+    // sort by name, keeping input order among equal names so the first row
+    // wins. Sorting the Recipes themselves would move two strings per swap
+    // and chase both names on every comparison; instead their 16-byte name
+    // prefixes are sorted with their positions, and names are only compared
+    // when the prefixes tie
+    struct SortKey {
+        BTreeKey<Recipe>::type prefix;
+        std::size_t position;
+    };
+    std::vector<SortKey> keys;
+    keys.reserve(recipes.size());
+    for (std::size_t i = 0; i < recipes.size(); i++) {
+        keys.push_back(SortKey{BTreeKey<Recipe>::of(recipes[i]), i});
+    }
+    std::sort(keys.begin(), keys.end(), [&recipes](const SortKey& a, const SortKey& b) {
+        if (!(a.prefix == b.prefix)) {
+            return a.prefix < b.prefix;
         }
-        if (current_node_ptr->getRightChildPtr() != nullptr) {
-            node_stack.push(current_node_ptr->getRightChildPtr());
+        int order = recipes[a.position].name_.compare(recipes[b.position].name_);
+        return order < 0 || (order == 0 && a.position < b.position);
+    });
+
+    std::vector<Recipe> sorted;
+    sorted.reserve(recipes.size());
+    for (const SortKey& key : keys) {
+        Recipe& recipe = recipes[key.position];
+        if (!sorted.empty() && sorted.back() == recipe) {
+            duplicate_names.push_back(std::move(recipe.name_));
+        } else {
+            sorted.push_back(std::move(recipe));
         }
     }
+    recipes.swap(sorted);
+
+    if (!isEmpty()) {
+        // merging into existing recipes goes through the normal insert
+        for (Recipe& recipe : recipes) {
+            // a rejected recipe is not moved from, so its name is still there
+            if (!addRecipe(std::move(recipe))) {
+                duplicate_names.push_back(std::move(recipe.name_));
+            }
+        }
+        return duplicate_names;
+    }
+
+    // only the tree is built: an empty book's indexes are empty too, and each
+    // is built from the loaded Recipes the first time it is used
+    clear();
+    Container::buildFromSorted(std::make_move_iterator(recipes.begin()), std::make_move_iterator(recipes.end()));
+    publishAll();
+    return duplicate_names;
+}
 
-    // if recipe not found
-    return nullptr;
+/**
+* Finds a Recipe in the tree by name.
+* @param name A const reference to the name.
+* @return A read-only pointer to the Recipe with the given name, or nullptr if
+not found.
+*/
+template <class Container>
+const Recipe* BasicRecipeBook<Container>::findRecipe(const std::string& name) const {
+    // the tree is ordered by name_, so a binary search by name is enough
+    return itemOf(Container::find(std::string_view(name)));
 }
 
 /**
@@ -106,14 +236,36 @@ level).
 * @return: True if the Recipe was successfully added; false if a Recipe with
 the same name already exists.
 */
-bool RecipeBook::addRecipe(const Recipe& recipe) {
+template <class Container>
+bool BasicRecipeBook<Container>::addRecipe(const Recipe& recipe) {
     // if name already in tree, cannot add
     if (findRecipe(recipe.name_) != nullptr) {
         return false;
     }
     // the BST add function adds new nodes based on equality 
     // (which is based on the override operaters for Recipe, which revolve around the name)
-    add(recipe);
+    Container::add(recipe);
+    indexAdded(recipe.name_);
+    return true;
+}
+
+/**
+* Adds a Recipe to the tree, moving its strings into the new node.
+* @param recipe An rvalue reference to a Recipe object.
+* @post: As addRecipe(const Recipe&). If a Recipe with the same name already
+exists, recipe is left untouched.
+* @return: True if the Recipe was successfully added; false if a Recipe with
+the same name already exists.
+*/
+template <class Container>
+bool BasicRecipeBook<Container>::addRecipe(Recipe&& recipe) {
+    if (findRecipe(recipe.name_) != nullptr) {
+        return false;
+    }
+    // recipe is moved from below, so the stored Recipe is found again by name
+    std::string name = recipe.name_;
+    Container::add(std::move(recipe));
+    indexAdded(name);
     return true;
 }
 
@@ -124,34 +276,132 @@ Recipe.
 * @post: If found, the Recipe is removed from the tree.
 * @return: True if the Recipe was successfully removed {} false otherwise.
 */
-bool RecipeBook::removeRecipe(const std::string& name) {
-    std::shared_ptr<BinaryNode<Recipe>> recipe_ptr = findRecipe(name);
+template <class Container>
+bool BasicRecipeBook<Container>::removeRecipe(const std::string& name) {
+    const Recipe* recipe_ptr = findRecipe(name);
     if (recipe_ptr == nullptr) {
         // no recipe to remove
         return false;
-    } else {
-        // return result of remove function
-        return remove(recipe_ptr->getItem());
     }
+    // drop the index entries first, while the recipe is still readable
+    unindexRecipe(*recipe_ptr);
+    return Container::removeKey(std::string_view(name));
 }
 
 /**
-* Clears all Recipes from the tree.
-* @post: The tree is emptied, and all nodes are deallocated.
+* Marks a Recipe as mastered or unmastered.
+* @param name A const reference to a string representing the name of the
+Recipe.
+* @param mastered The new value of the Recipe's mastered_ flag.
+* @post: The Recipe and the difficulty index agree on the new flag.
+* @return: True if the Recipe was found; false otherwise.
 */
-void RecipeBook::clear() {
-    // remove from left and right subtree until root has no children
-    while(!getRoot()->isLeaf()) {
-        if (getRoot()->getLeftChildPtr() != nullptr) {
-            remove(getRoot()->getLeftChildPtr()->getItem());
+template <class Container>
+bool BasicRecipeBook<Container>::setMastered(const std::string& name, bool mastered) {
+    // the one place a stored Recipe is changed; mastered_ is not part of the key
+    Recipe* recipe_ptr = itemOf(Container::find(std::string_view(name)));
+    if (recipe_ptr == nullptr) {
+        return false;
+    }
+    Recipe& recipe = *recipe_ptr;
+    if (recipe.mastered_ != mastered) {
+        // re-adding the entry recomputes the counts along its path
+        if (difficulty_indexed_) {
+            difficulty_index_.removeKey(DifficultyKey{recipe.difficulty_level_, name});
+        }
+        recipe.mastered_ = mastered;
+        if (difficulty_indexed_) {
+            difficulty_index_.emplace(recipe);
         }
-        if (getRoot()->getRightChildPtr() != nullptr) {
-            remove(getRoot()->getRightChildPtr()->getItem());
+        if (publishing_) {
+            // published Recipes are never changed: readers get a new copy
+            published_.replace(PublishedRecipe{std::make_shared<const Recipe>(recipe)});
         }
     }
+    return true;
+}
 
-    // remove root
-    remove(getRoot()->getItem());
+/**
+* Finds every Recipe whose name starts with prefix.
+* @param prefix The start of the names to match.
+* @return: The range [first, last) of the matching Recipes in name order.
+*/
+template <class Container>
+auto BasicRecipeBook<Container>::findRecipesByPrefix(std::string_view prefix) const -> std::pair<const_iterator, const_iterator> {
+    // the first name past the range is the prefix with its last character
+    // bumped; trailing '\xff' characters cannot be bumped and are dropped
+    std::string past_prefix(prefix);
+    while (!past_prefix.empty() && static_cast<unsigned char>(past_prefix.back()) == 0xFF) {
+        past_prefix.pop_back();
+    }
+    if (past_prefix.empty()) {
+        return {lower_bound(prefix), end()};
+    }
+    past_prefix.back() = static_cast<char>(static_cast<unsigned char>(past_prefix.back()) + 1);
+    return {lower_bound(prefix), lower_bound(std::string_view(past_prefix))};
+}
+
+/**
+* Name completion.
+* @param prefix What has been typed so far.
+* @param limit The most names to return.
+* @return: Up to limit names starting with prefix, in name order.
+*/
+template <class Container>
+std::vector<std::string> BasicRecipeBook<Container>::completeName(std::string_view prefix, std::size_t limit) const {
+    return nameIndex().complete(prefix, limit);
+}
+
+/**
+* Typo-tolerant name lookup.
+* @param name A possibly misspelled name.
+* @param max_distance The most single-character edits to allow.
+* @return: (name, distance) for every Recipe within max_distance edits of
+name, closest first.
+*/
+template <class Container>
+std::vector<std::pair<std::string, int>> BasicRecipeBook<Container>::findSimilarNames(std::string_view name, int max_distance) const {
+    return nameIndex().findWithin(name, max_distance);
+}
+
+/**
+* Keyword search over the descriptions.
+* @param query One or more words.
+* @return: The Recipes whose description_ contains every word of query.
+*/
+template <class Container>
+std::vector<const Recipe*> BasicRecipeBook<Container>::searchDescriptions(std::string_view query) const {
+    return recipesOf(descriptionIndex().findAll(query));
+}
+
+/**
+* Keyword search over the descriptions.
+* @param query One or more words.
+* @return: The Recipes whose description_ contains at least one word of
+query.
+*/
+template <class Container>
+std::vector<const Recipe*> BasicRecipeBook<Container>::searchDescriptionsAny(std::string_view query) const {
+    return recipesOf(descriptionIndex().findAny(query));
+}
+
+/**
+* Clears all Recipes from the tree.
+* @post: The tree is emptied, and all nodes are deallocated.
+*/
+template <class Container>
+void BasicRecipeBook<Container>::clear() {
+    // one O(n) sweep over the nodes, no remove() and no rebalancing;
+    // safe on an empty book
+    Container::clear();
+
+    difficulty_index_.clear();
+    difficulty_indexed_ = false;
+    description_index_.clear();
+    descriptions_indexed_ = false;
+    name_index_.clear();
+    names_indexed_ = false;
+    published_.clear();
 }
 
 /**
@@ -166,155 +416,204 @@ levels must also be mastered.
 the tree with a lower difficulty level than the given Recipe. Add one if the
 Recipe is not mastered.
 */
-int RecipeBook::calculateMasteryPoints(const std::string& name) {
-    int mastery_points = 0;
-
+template <class Container>
+int BasicRecipeBook<Container>::calculateMasteryPoints(const std::string& name) const {
     // if not found, return -1
-    if (findRecipe(name) == nullptr) {
+    const Recipe* recipe_ptr = findRecipe(name);
+    if (recipe_ptr == nullptr) {
         return -1;
     }
 
-    int difficulty_level = findRecipe(name)->getItem().difficulty_level_;
-
-    // using stack to hold the nodes
-    std::stack<std::shared_ptr<BinaryNode<Recipe>>> node_stack; 
-    node_stack.push(getRoot());
-
-    while (!node_stack.empty()) {
+    // if recipe already mastered, return 0
+    const Recipe& recipe = *recipe_ptr;
+    if (recipe.mastered_) {
+        return 0;
+    }
 
-        // focus on node at top of stack
-        std::shared_ptr<BinaryNode<Recipe>> current_node_ptr = node_stack.top();
-        Recipe this_recipe = current_node_ptr->getItem();
-        node_stack.pop();
-
-        // check if diffculty less than node & not mastered
-        if (this_recipe.difficulty_level_ < difficulty_level && !this_recipe.mastered_) {
-            mastery_points++;
-        } else if (this_recipe.name_ == name) {
-            // if choosen recipe not mastered, add one
-            if (!this_recipe.mastered_) {
-                mastery_points++;
-            } else {
-                // if recipe already mastered, return 0
-                return 0;
-            }
-        }
+    // every unmastered recipe below it, plus one for the recipe itself
+    return countBelow(recipe.difficulty_level_, true) + 1;
+}
 
-        // add left and right nodes to stack
-        if (current_node_ptr->getLeftChildPtr() != nullptr) {
-            node_stack.push(current_node_ptr->getLeftChildPtr());
+/**
+* Calculates the mastery points of every Recipe in one pass.
+* @param sink Called once per Recipe with its name and its mastery points, in
+order of difficulty level and then name.
+*/
+template <class Container>
+void BasicRecipeBook<Container>::calculateAllMasteryPoints(const std::function<void(const std::string& name, int points)>& sink) const {
+    // unmastered recipes at levels below the current one, and at the current one
+    int unmastered_below = 0;
+    int unmastered_at_level = 0;
+    bool first_entry = true;
+    int current_level = 0;
+
+    for (const DifficultyEntry& entry : difficultyIndex()) {
+        if (first_entry || entry.difficulty_level_ != current_level) {
+            // moving up a level: the previous level now counts as below
+            unmastered_below += unmastered_at_level;
+            unmastered_at_level = 0;
+            current_level = entry.difficulty_level_;
+            first_entry = false;
         }
-        if (current_node_ptr->getRightChildPtr() != nullptr) {
-            node_stack.push(current_node_ptr->getRightChildPtr());
+        if (entry.mastered_) {
+            sink(entry.name_, 0);
+        } else {
+            unmastered_at_level++;
+            sink(entry.name_, unmastered_below + 1);
         }
     }
+}
 
-    return mastery_points;
+/**
+* Calculates the mastery points of every Recipe in one pass.
+* @return: (name, mastery points) for every Recipe, in order of difficulty
+level and then name.
+*/
+template <class Container>
+std::vector<std::pair<std::string, int>> BasicRecipeBook<Container>::calculateAllMasteryPoints() const {
+    std::vector<std::pair<std::string, int>> points;
+    points.reserve(getNumberOfNodes());
+    calculateAllMasteryPoints([&points](const std::string& name, int recipe_points) {
+        points.emplace_back(name, recipe_points);
+    });
+    return points;
 }
 
 /**
-* Balances the tree.
-* @post: The tree is balanced such that for any node, the heights of its
-left and right subtrees differ by no more than 1.
-* @note: You may implement this by performing an inorder traversal to get
-sorted Recipes and rebuilding the tree.
-*/ 
-void RecipeBook::balance() {
-    std::stack<std::shared_ptr<BinaryNode<Recipe>>> node_stack; 
-    std::shared_ptr<BinaryNode<Recipe>> current_node = getRoot();
-
-    std::map<std::string, Recipe> name_and_recipe_vector; // name_, recipe
-    std::vector<std::string> name_list = {};
-
-    while (current_node != nullptr || !node_stack.empty()) {
-        // search left of subtree
-        while (current_node != nullptr) {
-            node_stack.push(current_node);
-            current_node = current_node->getLeftChildPtr();
-        }
+* Finds the Recipes in a range of difficulty levels.
+* @param lowest The lowest difficulty level to include.
+* @param highest The highest difficulty level to include.
+* @return: The range [first, last) of the index entries with lowest <=
+difficulty_level_ <= highest, ordered by difficulty level and then by name.
+*/
+template <class Container>
+std::pair<DifficultyIndex::const_iterator, DifficultyIndex::const_iterator> BasicRecipeBook<Container>::recipesByDifficulty(int lowest, int highest) const {
+    const DifficultyIndex& index = difficultyIndex();
+    if (lowest > highest) {
+        return {index.end(), index.end()};
+    }
+    // the empty name sorts before every name of the same level
+    DifficultyIndex::const_iterator first = index.lower_bound(DifficultyKey{lowest, ""});
+    if (highest == INT_MAX) {
+        return {first, index.end()};
+    }
+    return {first, index.lower_bound(DifficultyKey{highest + 1, ""})};
+}
 
-        // done travsering left bc found leaf
-        // return to root
-        current_node = node_stack.top();
-        // remove leaf 
-        node_stack.pop();
+/**
+* @param lowest The lowest difficulty level to count.
+* @param highest The highest difficulty level to count.
+* @return: The number of Recipes with lowest <= difficulty_level_ <= highest.
+*/
+template <class Container>
+int BasicRecipeBook<Container>::countRecipesByDifficulty(int lowest, int highest) const {
+    if (lowest > highest) {
+        return 0;
+    }
+    return countAtMost(highest, false) - countBelow(lowest, false);
+}
 
-        name_and_recipe_vector.insert({current_node->getItem().name_, current_node->getItem()});
-        name_list.push_back(current_node->getItem().name_);
+/**
+* @param lowest The lowest difficulty level to count.
+* @param highest The highest difficulty level to count.
+* @return: The number of unmastered Recipes with lowest <= difficulty_level_
+<= highest.
+*/
+template <class Container>
+int BasicRecipeBook<Container>::countUnmasteredByDifficulty(int lowest, int highest) const {
+    if (lowest > highest) {
+        return 0;
+    }
+    return countAtMost(highest, true) - countBelow(lowest, true);
+}
 
-        current_node = current_node->getRightChildPtr();
+/**
+* Finds the unmastered Recipe with the lowest difficulty level.
+* @return: A read-only pointer to it, or nullptr if every Recipe is mastered.
+*/
+template <class Container>
+const Recipe* BasicRecipeBook<Container>::nextRecipeToLearn() const {
+    std::shared_ptr<BinaryNode<DifficultyEntry>> current_node_ptr = difficultyIndex().getRoot();
+    if (current_node_ptr == nullptr || current_node_ptr->item().subtree_unmastered_ == 0) {
+        return nullptr;
     }
 
-    // sort diffculty_list
-    std::sort(name_list.begin(), name_list.end());
+    // follow the subtree counts to the leftmost unmastered entry
+    while (true) {
+        const std::shared_ptr<BinaryNode<DifficultyEntry>>& left_ptr = current_node_ptr->getLeftChildPtr();
+        if (left_ptr != nullptr && left_ptr->item().subtree_unmastered_ > 0) {
+            current_node_ptr = left_ptr;
+        } else if (!current_node_ptr->item().mastered_) {
+            return findRecipe(current_node_ptr->item().name_);
+        } else {
+            current_node_ptr = current_node_ptr->getRightChildPtr();
+        }
+    }
+}
 
-    // console log to check
+/**
+* @param highest A difficulty level.
+* @param unmastered_only Count only the unmastered Recipes.
+* @return The number of (unmastered) Recipes with a difficulty level of at
+most highest.
+*/
+template <class Container>
+int BasicRecipeBook<Container>::countAtMost(int highest, bool unmastered_only) const {
+    if (highest == INT_MAX) {
+        std::shared_ptr<BinaryNode<DifficultyEntry>> root_ptr = difficultyIndex().getRoot();
+        if (root_ptr == nullptr) {
+            return 0;
+        }
+        return unmastered_only ? root_ptr->item().subtree_unmastered_ : root_ptr->item().subtree_size_;
+    }
+    return countBelow(highest + 1, unmastered_only);
+}
 
-    // std::cout << "\n\tdiffculty_list:";
-    // for (int diff : diffculty_list) {
-    //     std::cout << " " << diff;
-    // }
-    // std::cout << std::endl;
+/**
+* @param difficulty_level A difficulty level.
+* @param unmastered_only Count only the unmastered Recipes.
+* @return The number of (unmastered) Recipes with a lower difficulty level.
+*/
+template <class Container>
+int BasicRecipeBook<Container>::countBelow(int difficulty_level, bool unmastered_only) const {
+    int count = 0;
+    std::shared_ptr<BinaryNode<DifficultyEntry>> current_node_ptr = difficultyIndex().getRoot();
+
+    while (current_node_ptr != nullptr) {
+        const DifficultyEntry& entry = current_node_ptr->item();
+        if (entry.difficulty_level_ < difficulty_level) {
+            // this entry and its whole left subtree are below the level
+            std::shared_ptr<BinaryNode<DifficultyEntry>> left_ptr = current_node_ptr->getLeftChildPtr();
+            if (left_ptr != nullptr) {
+                count += unmastered_only ? left_ptr->item().subtree_unmastered_ : left_ptr->item().subtree_size_;
+            }
+            if (!unmastered_only || !entry.mastered_) {
+                count++;
+            }
+            current_node_ptr = current_node_ptr->getRightChildPtr();
+        } else {
+            current_node_ptr = current_node_ptr->getLeftChildPtr();
+        }
+    }
 
-    // std::cout << "\trecipe: by diffculty: ";
-    // for (auto& [level, recipe] : name_and_recipe_vector) {
-    //     std::cout << recipe.name_ << " ";
-    // }
-    // std::cout << std::endl;
+    return count;
+}
 
-    clear();
-    
-    // pair recipe to range
-    std::queue<std::pair<Recipe,std::pair<int,int>>> recipe_queue;
-    // find middle value, it will be the root 
-    int l = 0;
-    int r = name_list.size()-1;
-    int mid = r / 2;
-    std::string name = name_list[mid];
-    // add root to queue
-    recipe_queue.push({name_and_recipe_vector[name], {0, r}});
-
-    // iterate through queue of recipes
-    // take recipe from front and add to tree
-    // add left and right children to queue
-        // children choose with modified binary search 
-    // pair recipe with the range of indices that contain it's possible children 
-    // repeat and find their children until no more recipes to add
-
-    while (!recipe_queue.empty()) {
-
-        // add recipe to tree and remove from queue
-        std::pair<Recipe,std::pair<int,int>> front = recipe_queue.front();
-        Recipe current_recipe = front.first;
-        add(current_recipe);
-        recipe_queue.pop();
-
-        // store range of the recipe
-        l = front.second.first;
-        r = front.second.second;
-        // finds new middle in the range
-        int index = l + (r-l) / 2;
-
-        // check range of recipes 
-        // std::cout << "\n\t" << current_recipe.name_ << " l: " << l << " r: " << r << " index: " << index;
-
-        // if there is a recipe to the left of middle in range, attempt to add middle recipe to queue
-        if (l < index) {
-            // 
-            mid = l + (index-1 - l) / 2;
-            name = name_list[mid];
-            Recipe left = name_and_recipe_vector[name];
-            // store with it's own range
-            recipe_queue.push({left,{l, index - 1}});
-        }
-        // if there is a recipe to the right of middle in range, attempt to add middle recipe to queue
-        if (r > index) {
-            mid = index + 1 + (r - index - 1) / 2;
-            name = name_list[mid];
-            Recipe right = name_and_recipe_vector[name];
-            // store with it's own range
-            recipe_queue.push({right,{index + 1, r}});
-        }
+/**
+* Balances the tree.
+* @post: The tree is balanced such that for any node, the heights of its
+left and right subtrees differ by no more than 1.
+* @note: You may implement this by performing an inorder traversal to get
+sorted Recipes and rebuilding the tree.
+*/ 
+template <class Container>
+void BasicRecipeBook<Container>::balance() {
+    // relinks the existing nodes around the middle of each inorder range, in
+    // O(n) and without copying any Recipe; the difficulty index gets the same
+    // treatment, its subtree counts are recomputed on the way up
+    Container::rebuildBalanced();
+    if (difficulty_indexed_) {
+        difficulty_index_.rebuildBalanced();
     }
 }
 
@@ -327,39 +626,335 @@ void RecipeBook::balance() {
 * Mastered: [Yes/No]
 * (Add an empty line between Recipes)
 */
-void RecipeBook::preorderDisplay() {
-    if (getRoot() == nullptr) {
+template <class Container>
+void BasicRecipeBook<Container>::preorderDisplay() {
+    // anything already sent through std::cout goes out first
+    std::cout.flush();
+    RecipeWriter writer(stdout);
+    renderPreorder(writer);
+    writer.flush();
+}
+
+/**
+* Renders the tree in preorder traversal.
+* @param writer The sink to render into, in any RecipeWriter format.
+* @post: Every Recipe is passed to writer in preorder, without being copied.
+writer is not flushed.
+* @return: True if every Recipe was rendered.
+*/
+template <class Container>
+bool BasicRecipeBook<Container>::renderPreorder(RecipeWriter& writer) const {
+    return renderFrom(getRoot(), writer);
+}
+
+/**
+* Starts or stops publishing versions of the book for reader threads.
+* @param publishing True to publish, false to stop.
+* @post: Turned on, the Recipes are published at once; turned off, the last
+version is dropped.
+*/
+template <class Container>
+void BasicRecipeBook<Container>::setPublishing(bool publishing) {
+    if (publishing == publishing_) {
         return;
     }
+    publishing_ = publishing;
+    if (publishing_) {
+        publishAll();
+    } else {
+        // readers still holding a version keep it alive
+        published_.clear();
+    }
+}
 
-    // using stack to hold the nodes
-    std::stack<std::shared_ptr<BinaryNode<Recipe>>> node_stack; 
-    node_stack.push(getRoot());
+/**
+* @return: True if changes to the book are being published.
+*/
+template <class Container>
+bool BasicRecipeBook<Container>::isPublishing() const {
+    return publishing_;
+}
+
+/**
+* @return: The latest published version of the book's Recipes.
+*/
+template <class Container>
+PublishedRecipes BasicRecipeBook<Container>::publishedRecipes() const {
+    // reads nothing but published_, whose snapshot is lock-free
+    PublishedRecipes recipes;
+    recipes.snapshot_ = published_.snapshot();
+    return recipes;
+}
+
+/**
+* Renders a binary tree in preorder.
+* @param root_ptr The root of the tree, nullptr if it is empty.
+* @param writer The sink to render into.
+* @return: True if every Recipe was rendered.
+*/
+template <class Container>
+bool BasicRecipeBook<Container>::renderFrom(const std::shared_ptr<const BinaryNode<Recipe>>& root_ptr, RecipeWriter& writer) {
+    // raw pointers: walking does not touch reference counts
+    std::vector<const BinaryNode<Recipe>*> node_stack;
+    if (root_ptr != nullptr) {
+        node_stack.push_back(root_ptr.get());
+    }
 
     while (!node_stack.empty()) {
-        std::shared_ptr<BinaryNode<Recipe>> current_node_ptr = node_stack.top();
-        Recipe this_recipe = current_node_ptr->getItem();
-        node_stack.pop();
-
-        // display recipe
-        std::cout << "Name: " << this_recipe.name_ << std::endl;
-        std::cout << "Difficulty Level: " << this_recipe.difficulty_level_ << std::endl;
-        std::cout << "Description: " << this_recipe.description_ << std::endl;
-        std::cout << "Mastered: ";
-        if (this_recipe.mastered_) {
-            std::cout << "Yes" << std::endl;
-        } else {
-            std::cout << "No" << std::endl;
+        const BinaryNode<Recipe>* current_node_ptr = node_stack.back();
+        node_stack.pop_back();
+        if (!writer.write(current_node_ptr->item())) {
+            return false;
         }
-        std::cout << std::endl;
 
-        // traverse left and right substrees if avaiblie 
+        // right first, so the left subtree is rendered first
         if (current_node_ptr->getRightChildPtr() != nullptr) {
-            node_stack.push(current_node_ptr->getRightChildPtr());
+            node_stack.push_back(current_node_ptr->getRightChildPtr().get());
         }
         if (current_node_ptr->getLeftChildPtr() != nullptr) {
-            node_stack.push(current_node_ptr->getLeftChildPtr());
+            node_stack.push_back(current_node_ptr->getLeftChildPtr().get());
+        }
+    }
+    return true;
+}
+
+/**
+* Renders a B-tree in preorder: the Recipes of a node, then its children.
+* @param root_ptr The root node, nullptr if the tree is empty.
+* @param writer The sink to render into.
+* @return: True if every Recipe was rendered.
+*/
+template <class Container>
+template <class Node>
+bool BasicRecipeBook<Container>::renderFrom(const Node* root_ptr, RecipeWriter& writer) {
+    std::vector<const Node*> node_stack;
+    if (root_ptr != nullptr) {
+        node_stack.push_back(root_ptr);
+    }
+
+    while (!node_stack.empty()) {
+        const Node* current_node_ptr = node_stack.back();
+        node_stack.pop_back();
+        for (int i = 0; i < current_node_ptr->count; i++) {
+            if (!writer.write(current_node_ptr->items[i])) {
+                return false;
+            }
         }
+
+        // last child first, so the first child's subtree is rendered first
+        if (!current_node_ptr->leaf) {
+            for (int i = current_node_ptr->count; i >= 0; i--) {
+                node_stack.push_back(current_node_ptr->children[i].get());
+            }
+        }
+    }
+    return true;
+}
+
+/**
+* Adds a Recipe to every secondary index.
+* @param recipe A Recipe that was just added to the tree.
+* @post: If an index throws, the others are left as they were.
+*/
+template <class Container>
+void BasicRecipeBook<Container>::indexRecipe(const Recipe& recipe) {
+    // all or nothing: if one index throws, the ones before it are undone
+    // indexes that were never used are not built yet and are skipped
+    int indexed = 0;
+    try {
+        if (difficulty_indexed_) {
+            difficulty_index_.emplace(recipe);
+        }
+        indexed++;
+        if (descriptions_indexed_) {
+            description_index_.addDocument(recipe.name_, recipe.description_);
+        }
+        indexed++;
+        if (names_indexed_) {
+            name_index_.insert(recipe.name_);
+        }
+        indexed++;
+        if (publishing_) {
+            published_.add(PublishedRecipe{std::make_shared<const Recipe>(recipe)});
+        }
+    } catch (...) {
+        if (indexed > 2 && names_indexed_) {
+            name_index_.remove(recipe.name_);
+        }
+        if (indexed > 1 && descriptions_indexed_) {
+            description_index_.removeDocument(recipe.name_);
+        }
+        if (indexed > 0 && difficulty_indexed_) {
+            difficulty_index_.removeKey(DifficultyKey{recipe.difficulty_level_, recipe.name_});
+        }
+        throw;
+    }
+}
+
+/**
+* Indexes a Recipe that was just added to the tree, or takes it out again.
+* @param name The name of the Recipe just added.
+* @post: The Recipe is in the tree and every index, or, if indexing threw,
+in none of them and the exception is passed on.
+*/
+template <class Container>
+void BasicRecipeBook<Container>::indexAdded(const std::string& name) {
+    // indexed from the stored Recipe, which is what the indexes describe
+    const Recipe* recipe_ptr = findRecipe(name);
+    try {
+        indexRecipe(*recipe_ptr);
+    } catch (...) {
+        Container::removeKey(std::string_view(name));
+        throw;
+    }
+}
+
+/**
+* Removes a Recipe from every secondary index.
+* @param recipe A Recipe that is about to be removed from the tree.
+*/
+template <class Container>
+void BasicRecipeBook<Container>::unindexRecipe(const Recipe& recipe) {
+    if (difficulty_indexed_) {
+        difficulty_index_.removeKey(DifficultyKey{recipe.difficulty_level_, recipe.name_});
+    }
+    if (descriptions_indexed_) {
+        description_index_.removeDocument(recipe.name_);
+    }
+    if (names_indexed_) {
+        name_index_.remove(recipe.name_);
+    }
+    if (publishing_) {
+        published_.removeKey(std::string_view(recipe.name_));
+    }
+}
+
+/**
+* @return: The difficulty index, built from the tree first if it is not.
+*/
+template <class Container>
+const DifficultyIndex& BasicRecipeBook<Container>::difficultyIndex() const {
+    if (!difficulty_indexed_) {
+        // the tree iterates in name order, so a stable sort of (level, rank)
+        // pairs gives (level, name) order without comparing any names
+        std::vector<const Recipe*> by_name;
+        by_name.reserve(getNumberOfNodes());
+        for (const Recipe& recipe : *this) {
+            by_name.push_back(&recipe);
+        }
+        std::vector<std::pair<int, std::uint32_t>> order; // (level, name rank)
+        order.reserve(by_name.size());
+        for (std::size_t i = 0; i < by_name.size(); i++) {
+            order.emplace_back(by_name[i]->difficulty_level_, static_cast<std::uint32_t>(i));
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<DifficultyEntry> entries;
+        entries.reserve(order.size());
+        for (const std::pair<int, std::uint32_t>& level_rank : order) {
+            entries.emplace_back(*by_name[level_rank.second]);
+        }
+        difficulty_index_.buildFromSorted(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+        difficulty_indexed_ = true;
+    }
+    return difficulty_index_;
+}
+
+/**
+* @return: The name index, built from the tree first if it is not.
+*/
+template <class Container>
+const TernarySearchTree& BasicRecipeBook<Container>::nameIndex() const {
+    if (!names_indexed_) {
+        std::vector<const std::string*> names;
+        names.reserve(getNumberOfNodes());
+        for (const Recipe& recipe : *this) {
+            names.push_back(&recipe.name_);
+        }
+
+        // names go into the ternary tree median first, as RecipeSnapshot orders
+        // its records: in sorted order every lo/hi sibling list would be a chain
+        name_index_.clear();
+        try {
+            std::vector<std::pair<std::size_t, std::size_t>> ranges; // (first, count)
+            ranges.push_back({0, names.size()});
+            while (!ranges.empty()) {
+                std::size_t first = ranges.back().first;
+                std::size_t count = ranges.back().second;
+                ranges.pop_back();
+                if (count == 0) {
+                    continue;
+                }
+                std::size_t mid = first + (count - 1) / 2;
+                name_index_.insert(*names[mid]);
+                ranges.push_back({mid + 1, first + count - mid - 1});
+                ranges.push_back({first, mid - first});
+            }
+        } catch (...) {
+            // a partial index is never used: the next lookup starts over
+            name_index_.clear();
+            throw;
+        }
+        names_indexed_ = true;
+    }
+    return name_index_;
+}
+
+/**
+* @return: The description index, built from the tree first if it is not.
+*/
+template <class Container>
+const TextIndex& BasicRecipeBook<Container>::descriptionIndex() const {
+    if (!descriptions_indexed_) {
+        // in name order, so the posting lists come out sorted by name too
+        description_index_.clear();
+        description_index_.reserve(getNumberOfNodes());
+        try {
+            for (const Recipe& recipe : *this) {
+                description_index_.addDocument(recipe.name_, recipe.description_);
+            }
+        } catch (...) {
+            // a partial index is never used: the next search starts over
+            description_index_.clear();
+            throw;
+        }
+        descriptions_indexed_ = true;
+    }
+    return description_index_;
+}
+
+/**
+* @param ids Ids returned by a query of description_index_.
+* @return: The Recipes with those ids, in the same order.
+*/
+template <class Container>
+std::vector<const Recipe*> BasicRecipeBook<Container>::recipesOf(const std::vector<std::uint32_t>& ids) const {
+    std::vector<const Recipe*> recipes;
+    recipes.reserve(ids.size());
+    for (std::uint32_t id : ids) {
+        recipes.push_back(findRecipe(description_index_.nameOf(id)));
+    }
+    return recipes;
+}
+
+/**
+* Publishes every Recipe of the book as one new version.
+* @post: Nothing is published unless the book is publishing.
+*/
+template <class Container>
+void BasicRecipeBook<Container>::publishAll() {
+    if (!publishing_) {
+        return;
+    }
+    // the tree iterates in name order, so the version is built without sorting
+    std::vector<PublishedRecipe> recipes;
+    recipes.reserve(getNumberOfNodes());
+    for (const Recipe& recipe : *this) {
+        recipes.push_back(PublishedRecipe{std::make_shared<const Recipe>(recipe)});
     }
+    published_.buildFromSorted(recipes.begin(), recipes.end());
 }
 
+// both books are compiled here once; RecipeBook.hpp declares them extern
+template class BasicRecipeBook<BinarySearchTree<Recipe, AvlBalance>>;
+template class BasicRecipeBook<BTree<Recipe>>;
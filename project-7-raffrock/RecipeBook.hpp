@@ -1,14 +1,21 @@
 /** 
-*@file StationManager.cpp 
+*@file RecipeBook.hpp 
 * Rafael Chetata
 * 12/16/24
-* Header file for RecipeBook class. It contained the recipe struct, and is a subclass of BinarySearchTree.
+* Header file for BasicRecipeBook<Container>, the Recipe struct and the indexes
+kept beside the Recipes. A BasicRecipeBook inherits privately from the tree it
+is given, which holds the Recipes ordered by name: RecipeBook is the book on
+an AVL BinarySearchTree, BTreeRecipeBook the same book on a BTree.
 */
 
 #ifndef RECIPEBOOK_HPP
 #define RECIPEBOOK_HPP
 
 #include "BinarySearchTree.hpp"
+#include "BTree.hpp"
+#include "TextIndex.hpp"
+#include "TernarySearchTree.hpp"
+#include "PersistentBinarySearchTree.hpp"
 
 #include <iostream>
 // to read in file
@@ -18,16 +25,23 @@
 // for string functions 
 #include <vector>
     // multiple use
-#include <map>
-    // map Recipe to index pairs
-#include <queue>
-    // for balance
 #include <stack>
     // for stacking notes
 #include <algorithm>
     // std::sort
 #include <utility>
     // std::pair
+#include <string_view>
+    // heterogeneous lookup by name
+#include <climits>
+    // INT_MIN, INT_MAX for open difficulty ranges
+#include <functional>
+    // std::function for streamed results
+#include <memory>
+    // std::shared_ptr for published Recipes
+
+// renders Recipes for preorderDisplay; it needs Recipe, so it is declared here
+class RecipeWriter;
 
 struct Recipe
 {
@@ -53,7 +67,7 @@ struct Recipe
     false).
     * @post: Initializes the Recipe with the provided values.
     */
-    Recipe(std::string name, int difficulty_level, std::string description, bool mastered = false) : name_(name), difficulty_level_(difficulty_level), description_(description), mastered_(mastered) {
+    Recipe(std::string name, int difficulty_level, std::string description, bool mastered = false) : name_(std::move(name)), difficulty_level_(difficulty_level), description_(std::move(description)), mastered_(mastered) {
     }
 
     /**
@@ -61,7 +75,7 @@ struct Recipe
     * @param other A const reference to another Recipe.
     * @return True if name_ is equal to other’s name_; false otherwise.
     */
-    bool operator== (const Recipe& other) {
+    bool operator== (const Recipe& other) const {
         return name_ == other.name_;
     }
    /**
@@ -70,7 +84,7 @@ struct Recipe
     * @return True if name_ is lexicographically less than other's name_; false
     otherwise
     */
-    bool operator< (const Recipe& other) {
+    bool operator< (const Recipe& other) const {
         return name_ < other.name_;
     }
    /**
@@ -79,20 +93,234 @@ struct Recipe
     * @return True if name_ is lexicographically greater than other's name_;
     false otherwise.
     */
-    bool operator> (const Recipe& other) {
+    bool operator> (const Recipe& other) const {
         return name_ > other.name_;
     }
 
+    /**
+    * Name comparisons, used by BinarySearchTree::find and removeKey so a
+    lookup by name does not have to build a temporary Recipe.
+    * @param name The name to compare name_ against.
+    */
+    bool operator== (std::string_view name) const {
+        return name_ == name;
+    }
+    bool operator< (std::string_view name) const {
+        return name_ < name;
+    }
+    bool operator> (std::string_view name) const {
+        return name_ > name;
+    }
+
+};
+
+/**
+* What a BTreeRecipeBook's nodes keep of each Recipe to search it: the first 16
+bytes of its name. Names that share them are told apart by the Recipes.
+*/
+template <>
+struct BTreeKey<Recipe>
+{
+    using type = BTreeStringPrefix;
+
+    static BTreeStringPrefix of(const Recipe& recipe) {
+        return BTreeStringPrefix::of(recipe.name_);
+    }
+    static BTreeStringPrefix of(std::string_view name) {
+        return BTreeStringPrefix::of(name);
+    }
+};
+
+/**
+* Key of the difficulty index: recipes are ordered by difficulty_level_, and
+by name_ among recipes of the same difficulty.
+*/
+struct DifficultyKey
+{
+    int difficulty_level_;
+    std::string_view name_;
+};
+
+/**
+* Entry of RecipeBook's difficulty index, one per Recipe.
+* subtree_size_ and subtree_unmastered_ summarize the subtree rooted at the
+entry's node (the entry included). They are kept up to date by the
+UnmasteredCount augment and must not be set by hand.
+*/
+struct DifficultyEntry
+{
+    int difficulty_level_;
+    std::string name_;
+    bool mastered_;
+    int subtree_size_;
+    int subtree_unmastered_;
+
+    DifficultyEntry() : difficulty_level_(0), name_(""), mastered_(false), subtree_size_(1), subtree_unmastered_(1) {
+    }
+
+    /**
+    * @param recipe The Recipe this entry indexes.
+    */
+    explicit DifficultyEntry(const Recipe& recipe) : difficulty_level_(recipe.difficulty_level_), name_(recipe.name_), mastered_(recipe.mastered_), subtree_size_(1), subtree_unmastered_(recipe.mastered_ ? 0 : 1) {
+    }
+
+    /**
+    * Comparisons by (difficulty_level_, name_), against another entry or a key.
+    */
+    bool operator== (const DifficultyKey& key) const {
+        return difficulty_level_ == key.difficulty_level_ && name_ == key.name_;
+    }
+    bool operator< (const DifficultyKey& key) const {
+        return difficulty_level_ < key.difficulty_level_ || (difficulty_level_ == key.difficulty_level_ && name_ < key.name_);
+    }
+    bool operator> (const DifficultyKey& key) const {
+        return difficulty_level_ > key.difficulty_level_ || (difficulty_level_ == key.difficulty_level_ && name_ > key.name_);
+    }
+    bool operator== (const DifficultyEntry& other) const {
+        return *this == other.key();
+    }
+    bool operator< (const DifficultyEntry& other) const {
+        return *this < other.key();
+    }
+    bool operator> (const DifficultyEntry& other) const {
+        return *this > other.key();
+    }
+
+    /**
+    * @return The key of this entry, viewing name_.
+    */
+    DifficultyKey key() const {
+        return DifficultyKey{difficulty_level_, name_};
+    }
+};
+
+/**
+* Augment for the difficulty index: recomputes an entry's subtree counts from
+its children whenever the AVL policy touches its node.
+*/
+struct UnmasteredCount
+{
+    static void update(BinaryNode<DifficultyEntry>& node) {
+        DifficultyEntry& entry = node.item();
+        entry.subtree_size_ = 1;
+        entry.subtree_unmastered_ = entry.mastered_ ? 0 : 1;
+        if (node.getLeftChildPtr() != nullptr) {
+            entry.subtree_size_ += node.getLeftChildPtr()->item().subtree_size_;
+            entry.subtree_unmastered_ += node.getLeftChildPtr()->item().subtree_unmastered_;
+        }
+        if (node.getRightChildPtr() != nullptr) {
+            entry.subtree_size_ += node.getRightChildPtr()->item().subtree_size_;
+            entry.subtree_unmastered_ += node.getRightChildPtr()->item().subtree_unmastered_;
+        }
+    }
+};
+
+/**
+* Secondary index of a RecipeBook: one DifficultyEntry per Recipe, ordered by
+(difficulty_level_, name_), with subtree counts for O(log n) counting.
+*/
+using DifficultyIndex = BinarySearchTree<DifficultyEntry, AugmentedAvlBalance<UnmasteredCount>>;
+
+/**
+* Entry of a RecipeBook's published versions: a shared copy of one Recipe that
+is never changed, ordered by name. Versions share their entries, so the path
+copied on each change copies pointers, not Recipes.
+*/
+struct PublishedRecipe
+{
+    std::shared_ptr<const Recipe> recipe_;
+
+    /**
+    * Comparisons by name, against another entry or a name.
+    */
+    bool operator== (const PublishedRecipe& other) const {
+        return recipe_->name_ == other.recipe_->name_;
+    }
+    bool operator< (const PublishedRecipe& other) const {
+        return recipe_->name_ < other.recipe_->name_;
+    }
+    bool operator> (const PublishedRecipe& other) const {
+        return recipe_->name_ > other.recipe_->name_;
+    }
+    bool operator== (std::string_view name) const {
+        return recipe_->name_ == name;
+    }
+    bool operator< (std::string_view name) const {
+        return recipe_->name_ < name;
+    }
+    bool operator> (std::string_view name) const {
+        return recipe_->name_ > name;
+    }
 };
 
-class RecipeBook : public BinarySearchTree<Recipe> {
+/**
+* What a reader thread sees of a RecipeBook: its Recipes as of one change,
+never changed afterwards. Taking one and searching it never waits on the
+thread changing the book. Cheap to copy.
+*/
+class PublishedRecipes {
 
 public:
+    /**
+    * Finds a Recipe by name, in O(log n), without locking.
+    * @param name The name of the Recipe.
+    * @return A read-only pointer to the Recipe, or nullptr if not found. It
+    stays valid as long as this PublishedRecipes, or a copy of it, lives.
+    */
+    const Recipe* findRecipe(std::string_view name) const {
+        const PublishedRecipe* entry = snapshot_.find(name);
+        return entry == nullptr ? nullptr : entry->recipe_.get();
+    }
+
+    /**
+    * @return: The number of Recipes in this version.
+    */
+    int getNumberOfNodes() const {
+        return snapshot_.getNumberOfNodes();
+    }
+
+    /**
+    * @return: True if this version holds no Recipe.
+    */
+    bool isEmpty() const {
+        return snapshot_.isEmpty();
+    }
+
+private:
+    template <class Container>
+    friend class BasicRecipeBook;
+
+    PersistentBinarySearchTree<PublishedRecipe>::Snapshot snapshot_;
+};
+
+// Container is the tree the Recipes live in, ordered by name: RecipeBook
+// (below the class) keeps them in an AVL tree, BTreeRecipeBook in a B-tree.
+// Either one is O(log n) tall on every add and remove, even when the CSV is
+// already sorted by name.
+// The container is a private base: every change has to go through the members
+// below, which keep the secondary indexes in step with it, so only its
+// read-only members are made public again.
+template <class Container>
+class BasicRecipeBook : private Container {
+
+public:
+    using typename Container::const_iterator;
+    using typename Container::iterator;
+    using Container::isEmpty;
+    using Container::getHeight;
+    using Container::getNumberOfNodes;
+    using Container::contains;
+    using Container::begin;
+    using Container::end;
+    using Container::lower_bound;
+    using Container::upper_bound;
+    using Container::equal_range;
+
     /**
     * Default Constructor.
     * @post: Initializes an empty RecipeBook.
     */
-    RecipeBook();
+    BasicRecipeBook();
 
     /**
     * Parameterized Constructor.
@@ -103,16 +331,69 @@ public:
     *   name,difficulty_level,description,mastered
     * Ignore the first line. Each subsequent line represents a Recipe to be
     added to the RecipeBook.
+    * @note: Rows repeating an earlier name are skipped; call loadRecipes on an
+    empty RecipeBook to get their names.
     */
-    RecipeBook(const std::string& filename);
+    BasicRecipeBook(const std::string& filename);
+
+    /**
+    * Loads Recipes from a CSV file.
+    * @param filename A const reference to a string representing the name of a
+    CSV file, in the format described for the parameterized constructor.
+    * @post: Every Recipe whose name is not already in the book, and not
+    repeated earlier in the file, is added. Into an empty book, all rows are
+    parsed first, sorted and deduplicated by name, and the tree is built
+    balanced in one O(n) pass instead of one addRecipe per row. The indexes
+    are left to be built when first used, so a plain load only pays for the
+    tree.
+    * @return: The names that were skipped because a Recipe with the same name
+    was already in the book or earlier in the file, once per skipped row.
+    */
+    std::vector<std::string> loadRecipes(const std::string& filename);
+
+    /**
+    * Loads a snapshot file written by RecipeSnapshot::write.
+    * @param filename The snapshot file.
+    * @post: If the file is a valid snapshot, the book holds exactly its
+    Recipes and anything in it before is cleared; otherwise the book is left
+    unchanged. The records are mapped, not parsed, and they come already in
+    name order, so the tree is built straight from them: nothing is sorted,
+    deduplicated or compared. As after loadRecipes, the indexes are built
+    when first used.
+    * @return: True if the file was loaded.
+    */
+    bool loadSnapshot(const std::string& filename);
+
+    /**
+    * Adds many Recipes at once.
+    * @param recipes The Recipes to add, in any order.
+    * @post: Every Recipe whose name is not already in the book, and not
+    repeated earlier in recipes, is added. Into an empty book, the tree is
+    built balanced in one O(n) pass after sorting, which is cheap when
+    recipes is already in name order, and the indexes are built on first
+    use.
+    * @return: The names that were skipped because a Recipe with the same name
+    was already in the book or earlier in recipes, once per skipped Recipe.
+    */
+    std::vector<std::string> addRecipes(std::vector<Recipe> recipes);
+
+    /**
+    * @return: The root of the tree, read-only, or nullptr if the book is empty:
+    a std::shared_ptr<const BinaryNode<Recipe>> for RecipeBook, a pointer to a
+    const BTree node for BTreeRecipeBook.
+    */
+    auto getRoot() const {
+        return readOnly(Container::getRoot());
+    }
 
     /**
     * Finds a Recipe in the tree by name.
     * @param name A const reference to the name.
-    * @return A pointer to the node containing the Recipe with the given
-    difficulty level, or nullptr if not found.
+    * @return A pointer to the Recipe with the given name, or nullptr if not
+    found. It is read-only: change mastered_ through setMastered. It is
+    invalidated by removing that Recipe or clearing the book.
     */
-    std::shared_ptr<BinaryNode<Recipe>> findRecipe(const std::string& name);
+    const Recipe* findRecipe(const std::string& name) const;
 
    /**
     * Adds a Recipe to the tree.
@@ -125,6 +406,16 @@ public:
     */
     bool addRecipe(const Recipe& recipe);
 
+    /**
+    * Adds a Recipe to the tree, moving its strings into the new node.
+    * @param recipe An rvalue reference to a Recipe object.
+    * @post: As addRecipe(const Recipe&). If a Recipe with the same name
+    already exists, recipe is left untouched.
+    * @return: True if the Recipe was successfully added; false if a Recipe with
+    the same name already exists.
+    */
+    bool addRecipe(Recipe&& recipe);
+
     /**
     * Removes a Recipe from the tree by name.
     * @param name A const reference to a string representing the name of the
@@ -134,6 +425,65 @@ public:
     */
     bool removeRecipe(const std::string& name);
 
+    /**
+    * Marks a Recipe as mastered or unmastered.
+    * @param name A const reference to a string representing the name of the
+    Recipe.
+    * @param mastered The new value of the Recipe's mastered_ flag.
+    * @post: The Recipe and the difficulty index agree on the new flag.
+    * @return: True if the Recipe was found; false otherwise.
+    */
+    bool setMastered(const std::string& name, bool mastered);
+
+    /**
+    * Finds every Recipe whose name starts with prefix.
+    * @param prefix The start of the names to match; an empty prefix matches
+    every Recipe.
+    * @return: The range [first, last) of the matching Recipes in name order.
+    It is found with two O(log n) descents, without visiting the Recipes
+    outside it, and is invalidated by adding or removing a Recipe.
+    */
+    std::pair<const_iterator, const_iterator> findRecipesByPrefix(std::string_view prefix) const;
+
+    /**
+    * Name completion.
+    * @param prefix What has been typed so far.
+    * @param limit The most names to return.
+    * @return: Up to limit names starting with prefix, in name order. The
+    first call after a load builds the name index, in O(total name length).
+    */
+    std::vector<std::string> completeName(std::string_view prefix, std::size_t limit = 10) const;
+
+    /**
+    * Typo-tolerant name lookup.
+    * @param name A possibly misspelled name.
+    * @param max_distance The most single-character insertions, deletions and
+    substitutions to allow.
+    * @return: (name, distance) for every Recipe within max_distance edits of
+    name, closest first. Branches of the name index that are already too far
+    off are not explored. Uses the same name index as completeName.
+    */
+    std::vector<std::pair<std::string, int>> findSimilarNames(std::string_view name, int max_distance = 2) const;
+
+    /**
+    * Keyword search over the descriptions.
+    * @param query One or more words; case and punctuation are ignored.
+    * @return: The Recipes whose description_ contains every word of query,
+    invalidated by any change to the book. Answered from an inverted index
+    without reading any description; the index is built from the book in
+    O(total description length) by the first search, so books that are
+    never searched do not pay for it, and is kept up to date from then on.
+    */
+    std::vector<const Recipe*> searchDescriptions(std::string_view query) const;
+
+    /**
+    * Keyword search over the descriptions.
+    * @param query One or more words; case and punctuation are ignored.
+    * @return: The Recipes whose description_ contains at least one word of
+    query, invalidated by any change to the book.
+    */
+    std::vector<const Recipe*> searchDescriptionsAny(std::string_view query) const;
+
     /**
     * Clears all Recipes from the tree.
     * @post: The tree is emptied, and all nodes are deallocated.
@@ -151,8 +501,65 @@ Recipe.
     * Note: Mastery points are calculated as the number of unmastered Recipes in
     the tree with a lower difficulty level than the given Recipe. Add one if the
     Recipe is not mastered.
+    * @note: Runs in O(log n) using the difficulty index. The first call after
+    a load, like the first of any difficulty query, builds the index in
+    O(n log n) without comparing names.
+    */
+    int calculateMasteryPoints(const std::string& name) const;
+
+    /**
+    * Calculates the mastery points of every Recipe in one pass.
+    * @param sink Called once per Recipe with its name and its mastery points,
+    as calculateMasteryPoints would return them, in order of difficulty level
+    and then name. Results are streamed: nothing is collected.
+    * @note: Runs in O(n) total by walking the difficulty index once with a
+    running count of the unmastered Recipes at lower levels. The book must not
+    be changed from inside sink.
     */
-    int calculateMasteryPoints(const std::string& name);
+    void calculateAllMasteryPoints(const std::function<void(const std::string& name, int points)>& sink) const;
+
+    /**
+    * Calculates the mastery points of every Recipe in one pass.
+    * @return: (name, mastery points) for every Recipe, in order of difficulty
+    level and then name.
+    */
+    std::vector<std::pair<std::string, int>> calculateAllMasteryPoints() const;
+
+    /**
+    * Finds the Recipes in a range of difficulty levels.
+    * @param lowest The lowest difficulty level to include.
+    * @param highest The highest difficulty level to include.
+    * @return: The range [first, last) of the index entries with lowest <=
+    difficulty_level_ <= highest, ordered by difficulty level and then by name.
+    Each entry carries the Recipe's name_, difficulty_level_ and mastered_.
+    It is found with two O(log n) descents and is invalidated by any change
+    to the book.
+    */
+    std::pair<DifficultyIndex::const_iterator, DifficultyIndex::const_iterator> recipesByDifficulty(int lowest = INT_MIN, int highest = INT_MAX) const;
+
+    /**
+    * @param lowest The lowest difficulty level to count.
+    * @param highest The highest difficulty level to count.
+    * @return: The number of Recipes with lowest <= difficulty_level_ <=
+    highest, in O(log n).
+    */
+    int countRecipesByDifficulty(int lowest, int highest) const;
+
+    /**
+    * @param lowest The lowest difficulty level to count.
+    * @param highest The highest difficulty level to count.
+    * @return: The number of unmastered Recipes with lowest <=
+    difficulty_level_ <= highest, in O(log n).
+    */
+    int countUnmasteredByDifficulty(int lowest, int highest) const;
+
+    /**
+    * Finds what to learn next: the unmastered Recipe with the lowest
+    difficulty level, the first by name among equals.
+    * @return: A read-only pointer to it, or nullptr if every Recipe is
+    mastered. Runs in O(log n).
+    */
+    const Recipe* nextRecipeToLearn() const;
 
     /**
     * Balances the tree.
@@ -160,6 +567,8 @@ Recipe.
     left and right subtrees differ by no more than 1.
     * @note: You may implement this by performing an inorder traversal to get
     sorted Recipes and rebuilding the tree.
+    * @note: The AVL base already keeps the heights of sibling subtrees within
+    1 of each other, so calling this is optional.
     */
     void balance();
 
@@ -171,9 +580,179 @@ Recipe.
     * Description: [description_]
     * Mastered: [Yes/No]
     * (Add an empty line between Recipes)
+    * Written to stdout in large blocks through a RecipeWriter.
     */
     void preorderDisplay();
 
+    /**
+    * Renders the tree in preorder traversal.
+    * @param writer The sink to render into, in any RecipeWriter format.
+    * @post: Every Recipe is passed to writer in preorder, without being
+    copied. writer is not flushed.
+    * @return: True if every Recipe was rendered.
+    */
+    bool renderPreorder(RecipeWriter& writer) const;
+
+    /**
+    * Starts or stops publishing versions of the book for reader threads.
+    * @param publishing True to publish, false to stop.
+    * @post: Turned on, the Recipes are published at once in O(n), and from
+    then on every change to the book publishes a new version, in O(log n)
+    more per change. Turned off, nothing more is published and the book's
+    hold on the last version is dropped.
+    */
+    void setPublishing(bool publishing);
+
+    /**
+    * @return: True if changes to the book are being published.
+    */
+    bool isPublishing() const;
+
+    /**
+    * The one member that may be called from any thread while another thread
+    changes the book; every other member belongs to that thread.
+    * @return: The latest published version of the book's Recipes; empty if
+    the book is not publishing.
+    */
+    PublishedRecipes publishedRecipes() const;
+
+private:
+    // The secondary indexes are built from the tree by the first query that
+    // needs them and only maintained from then on: a book that is loaded and
+    // read by name pays for none of them. A const query can therefore write
+    // them, and the book is not safe to share between threads without a lock.
+
+    // every Recipe keyed by (difficulty_level_, name_), with subtree counts
+    // of unmastered Recipes, so mastery points are one O(log n) descent
+    mutable DifficultyIndex difficulty_index_;
+    mutable bool difficulty_indexed_;
+    // words of every description_ -> names of the Recipes using them
+    mutable TextIndex description_index_;
+    mutable bool descriptions_indexed_;
+    // every name_, one character per node, for completion and fuzzy lookups
+    mutable TernarySearchTree name_index_;
+    mutable bool names_indexed_;
+    // a name-ordered copy of the Recipes for reader threads, updated by
+    // path copying while publishing_ is set
+    bool publishing_;
+    PersistentBinarySearchTree<PublishedRecipe> published_;
+
+    /**
+    * Adds a Recipe to every secondary index.
+    * @param recipe A Recipe that was just added to the tree.
+    * @post: If an index throws, the others are left as they were.
+    */
+    void indexRecipe(const Recipe& recipe);
+
+    /**
+    * Indexes a Recipe that was just added to the tree, or takes it out again.
+    * @param name The name of the Recipe just added.
+    * @post: The Recipe is in the tree and every index, or, if indexing threw,
+    in none of them and the exception is passed on.
+    */
+    void indexAdded(const std::string& name);
+
+    /**
+    * Removes a Recipe from every secondary index.
+    * @param recipe A Recipe that is about to be removed from the tree.
+    */
+    void unindexRecipe(const Recipe& recipe);
+
+    /**
+    * @return: The difficulty index, built from the tree first if no
+    difficulty query was made since the book was loaded or cleared.
+    */
+    const DifficultyIndex& difficultyIndex() const;
+
+    /**
+    * @return: The name index, built from the tree first if no name
+    completion or fuzzy lookup was made since the book was loaded or cleared.
+    */
+    const TernarySearchTree& nameIndex() const;
+
+    /**
+    * @return: The description index, built from the tree first if no
+    description search was made since the book was loaded or cleared.
+    */
+    const TextIndex& descriptionIndex() const;
+
+    /**
+    * @param ids Ids returned by a query of description_index_.
+    * @return: The Recipes with those ids, in the same order.
+    */
+    std::vector<const Recipe*> recipesOf(const std::vector<std::uint32_t>& ids) const;
+
+    /**
+    * @post: If publishing, every Recipe of the book is published as one new
+    version, for the loads that build the book in one pass.
+    */
+    void publishAll();
+
+    /**
+    * @param difficulty_level A difficulty level.
+    * @param unmastered_only Count only the unmastered Recipes.
+    * @return The number of (unmastered) Recipes with a lower difficulty level.
+    */
+    int countBelow(int difficulty_level, bool unmastered_only) const;
+
+    /**
+    * @param highest A difficulty level.
+    * @param unmastered_only Count only the unmastered Recipes.
+    * @return The number of (unmastered) Recipes with a difficulty level of at
+    most highest.
+    */
+    int countAtMost(int highest, bool unmastered_only) const;
+
+    /**
+    * The containers' lookups return a node or a pointer to the item; these
+    turn either into a pointer to the Recipe, nullptr if it was not found.
+    */
+    static Recipe* itemOf(const std::shared_ptr<BinaryNode<Recipe>>& node_ptr) {
+        return node_ptr == nullptr ? nullptr : &node_ptr->item();
+    }
+    static Recipe* itemOf(Recipe* recipe_ptr) {
+        return recipe_ptr;
+    }
+    static const Recipe* itemOf(const Recipe* recipe_ptr) {
+        return recipe_ptr;
+    }
+
+    /**
+    * @return: A container's root, without write access to the Recipes.
+    */
+    static std::shared_ptr<const BinaryNode<Recipe>> readOnly(std::shared_ptr<BinaryNode<Recipe>> node_ptr) {
+        return node_ptr;
+    }
+    template <class Node>
+    static const Node* readOnly(const Node* node_ptr) {
+        return node_ptr;
+    }
+
+    /**
+    * Renders the tree under root_ptr in preorder, for renderPreorder.
+    * @param root_ptr A root as getRoot returns it.
+    * @param writer The sink to render into.
+    * @return: True if every Recipe was rendered.
+    */
+    static bool renderFrom(const std::shared_ptr<const BinaryNode<Recipe>>& root_ptr, RecipeWriter& writer);
+    template <class Node>
+    static bool renderFrom(const Node* root_ptr, RecipeWriter& writer);
+
 };
 
+/**
+* The book as main and the tools use it, on an AVL tree.
+*/
+using RecipeBook = BasicRecipeBook<BinarySearchTree<Recipe, AvlBalance>>;
+
+/**
+* The same book on a B-tree: fewer, wider nodes, one cache-friendly array of
+Recipes per node.
+*/
+using BTreeRecipeBook = BasicRecipeBook<BTree<Recipe>>;
+
+// both are compiled once, in RecipeBook.cpp
+extern template class BasicRecipeBook<BinarySearchTree<Recipe, AvlBalance>>;
+extern template class BasicRecipeBook<BTree<Recipe>>;
+
 # endif
\ No newline at end of file
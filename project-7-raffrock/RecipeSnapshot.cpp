@@ -0,0 +1,372 @@
+/**
+*@file RecipeSnapshot.cpp
+* Implementation file for the binary RecipeBook snapshot format.
+*/
+
+#include "RecipeSnapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char SNAPSHOT_MAGIC[8] = {'R', 'C', 'P', 'S', 'N', 'A', 'P', '\0'};
+
+/**
+* Default Constructor.
+* @post: Initializes a closed snapshot.
+*/
+RecipeSnapshot::RecipeSnapshot() : mapping_(nullptr), mapping_size_(0), records_(nullptr), difficulty_order_(nullptr), pool_(nullptr), record_count_(0) {
+}
+
+/**
+* Parameterized Constructor.
+* @param filename The snapshot file to open.
+* @post: The file is mapped if it is a valid snapshot; check isOpen.
+*/
+RecipeSnapshot::RecipeSnapshot(const std::string& filename) : RecipeSnapshot() {
+    open(filename);
+}
+
+/**
+* Destructor.
+* @post: The file is unmapped.
+*/
+RecipeSnapshot::~RecipeSnapshot() {
+    close();
+}
+
+/**
+* Walks the records in name order.
+* @param visit Called with each record position, in name order.
+*/
+template <class Visit>
+void RecipeSnapshot::visitInNameOrder(Visit visit) const {
+    // inorder walk of the implicit tree: lower half, the record, upper half
+    struct Step
+    {
+        std::size_t index;
+        std::size_t count;
+        bool emit;
+    };
+    std::vector<Step> steps;
+    if (record_count_ > 0) {
+        steps.push_back(Step{0, record_count_, false});
+    }
+    while (!steps.empty()) {
+        Step step = steps.back();
+        steps.pop_back();
+        if (step.emit) {
+            visit(static_cast<std::uint32_t>(step.index));
+            continue;
+        }
+        std::size_t lower_count = (step.count - 1) / 2;
+        std::size_t upper_count = step.count - 1 - lower_count;
+        if (upper_count > 0) {
+            steps.push_back(Step{step.index + 1 + lower_count, upper_count, false});
+        }
+        steps.push_back(Step{step.index, 1, true});
+        if (lower_count > 0) {
+            steps.push_back(Step{step.index + 1, lower_count, false});
+        }
+    }
+}
+
+/**
+* Writes a snapshot of a RecipeBook.
+* @param book The RecipeBook to save.
+* @param filename The file to create or replace.
+* @return: True if the whole file was written; false otherwise.
+*/
+bool RecipeSnapshot::write(const RecipeBook& book, const std::string& filename) {
+    // the book iterates in name order
+    std::vector<const Recipe*> sorted;
+    sorted.reserve(book.getNumberOfNodes());
+    for (const Recipe& recipe : book) {
+        sorted.push_back(&recipe);
+    }
+
+    // each distinct string goes into the pool once
+    std::string pool;
+    std::unordered_map<std::string_view, std::uint32_t> pooled;
+    bool pool_overflow = false;
+    auto intern = [&](const std::string& text) -> std::uint32_t {
+        auto found = pooled.find(text);
+        if (found != pooled.end()) {
+            return found->second;
+        }
+        if (pool.size() + text.size() > UINT32_MAX) {
+            pool_overflow = true;
+            return 0;
+        }
+        std::uint32_t offset = static_cast<std::uint32_t>(pool.size());
+        pool += text;
+        pooled.emplace(text, offset);
+        return offset;
+    };
+
+    // preorder of the balanced tree over sorted: a range's middle, then its
+    // lower half, then its upper half; the stack holds [first, last) ranges
+    std::vector<SnapshotRecord> records;
+    records.reserve(sorted.size());
+    std::vector<const Recipe*> preorder;
+    preorder.reserve(sorted.size());
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    if (!sorted.empty()) {
+        ranges.push_back({0, sorted.size()});
+    }
+    while (!ranges.empty()) {
+        std::size_t first = ranges.back().first;
+        std::size_t last = ranges.back().second;
+        ranges.pop_back();
+        std::size_t mid = first + (last - first - 1) / 2;
+
+        const Recipe& recipe = *sorted[mid];
+        SnapshotRecord record;
+        record.name_offset = intern(recipe.name_);
+        record.name_length = static_cast<std::uint32_t>(recipe.name_.size());
+        record.description_offset = intern(recipe.description_);
+        record.description_length = static_cast<std::uint32_t>(recipe.description_.size());
+        record.difficulty_level = recipe.difficulty_level_;
+        record.mastered = recipe.mastered_ ? 1 : 0;
+        records.push_back(record);
+        preorder.push_back(&recipe);
+
+        if (mid + 1 < last) {
+            ranges.push_back({mid + 1, last});
+        }
+        if (first < mid) {
+            ranges.push_back({first, mid});
+        }
+    }
+    if (pool_overflow || records.size() > UINT32_MAX) {
+        return false;
+    }
+
+    std::vector<std::uint32_t> difficulty_order(records.size());
+    for (std::size_t i = 0; i < difficulty_order.size(); i++) {
+        difficulty_order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(difficulty_order.begin(), difficulty_order.end(), [&preorder](std::uint32_t a, std::uint32_t b) {
+        const Recipe& first = *preorder[a];
+        const Recipe& second = *preorder[b];
+        return first.difficulty_level_ < second.difficulty_level_
+            || (first.difficulty_level_ == second.difficulty_level_ && first.name_ < second.name_);
+    });
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.record_count = static_cast<std::uint32_t>(records.size());
+    header.records_offset = sizeof(SnapshotHeader);
+    header.difficulty_order_offset = header.records_offset + records.size() * sizeof(SnapshotRecord);
+    header.pool_offset = header.difficulty_order_offset + difficulty_order.size() * sizeof(std::uint32_t);
+    header.pool_size = pool.size();
+
+    std::ofstream snapshot_file(filename, std::ios::binary | std::ios::trunc);
+    snapshot_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    snapshot_file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SnapshotRecord));
+    snapshot_file.write(reinterpret_cast<const char*>(difficulty_order.data()), difficulty_order.size() * sizeof(std::uint32_t));
+    snapshot_file.write(pool.data(), pool.size());
+    snapshot_file.close();
+    return !snapshot_file.fail();
+}
+
+/**
+* Maps a snapshot file.
+* @param filename The snapshot file to open.
+* @return: True if the file was mapped and is consistent; false otherwise.
+*/
+bool RecipeSnapshot::open(const std::string& filename) {
+    close();
+
+    int descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat file_status;
+    if (fstat(descriptor, &file_status) != 0 || file_status.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        ::close(descriptor);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(file_status.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // the mapping keeps the file alive on its own
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = mapping;
+    mapping_size_ = size;
+
+    // check everything find and at will rely on, once, up front
+    const char* bytes = static_cast<const char*>(mapping_);
+    SnapshotHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    bool valid = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0
+        && header.version == VERSION
+        && header.records_offset % alignof(SnapshotRecord) == 0
+        && header.records_offset <= size
+        && header.record_count <= (size - header.records_offset) / sizeof(SnapshotRecord)
+        && header.difficulty_order_offset % alignof(std::uint32_t) == 0
+        && header.difficulty_order_offset <= size
+        && header.record_count <= (size - header.difficulty_order_offset) / sizeof(std::uint32_t)
+        && header.pool_offset <= size
+        && header.pool_size <= size - header.pool_offset;
+    if (!valid) {
+        close();
+        return false;
+    }
+    records_ = reinterpret_cast<const SnapshotRecord*>(bytes + header.records_offset);
+    difficulty_order_ = reinterpret_cast<const std::uint32_t*>(bytes + header.difficulty_order_offset);
+    pool_ = bytes + header.pool_offset;
+    record_count_ = header.record_count;
+    for (std::size_t i = 0; i < record_count_; i++) {
+        const SnapshotRecord& record = records_[i];
+        if (std::uint64_t(record.name_offset) + record.name_length > header.pool_size
+            || std::uint64_t(record.description_offset) + record.description_length > header.pool_size) {
+            close();
+            return false;
+        }
+    }
+
+    // find and RecipeBook::loadSnapshot trust both orders, so they are
+    // checked here: each name must be greater than the one before it
+    bool ordered = true;
+    const SnapshotRecord* previous = nullptr;
+    visitInNameOrder([&](std::uint32_t index) {
+        if (previous != nullptr && !(nameOf(*previous) < nameOf(records_[index]))) {
+            ordered = false;
+        }
+        previous = &records_[index];
+    });
+    for (std::size_t i = 0; ordered && i < record_count_; i++) {
+        if (difficulty_order_[i] >= record_count_) {
+            ordered = false;
+        } else if (i > 0) {
+            // strictly increasing keys also mean no position is listed twice
+            const SnapshotRecord& before = records_[difficulty_order_[i - 1]];
+            const SnapshotRecord& record = records_[difficulty_order_[i]];
+            ordered = before.difficulty_level < record.difficulty_level
+                || (before.difficulty_level == record.difficulty_level && nameOf(before) < nameOf(record));
+        }
+    }
+    if (!ordered) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+* @post: The file is unmapped; views returned earlier are invalidated.
+*/
+void RecipeSnapshot::close() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_size_);
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    records_ = nullptr;
+    difficulty_order_ = nullptr;
+    pool_ = nullptr;
+    record_count_ = 0;
+}
+
+/**
+* @return: True if a snapshot is mapped.
+*/
+bool RecipeSnapshot::isOpen() const {
+    return mapping_ != nullptr;
+}
+
+/**
+* @return: The number of Recipes in the snapshot.
+*/
+std::size_t RecipeSnapshot::size() const {
+    return record_count_;
+}
+
+/**
+* Finds a Recipe by name in O(log n), without allocating.
+* @param name The name of the Recipe.
+* @return: A view of the Recipe, or nothing if not found.
+*/
+std::optional<RecipeView> RecipeSnapshot::find(std::string_view name) const {
+    // (index, count): the subtree rooted at records_[index] holds count records,
+    // its lower half right after it and its upper half after that
+    std::size_t index = 0;
+    std::size_t count = record_count_;
+    while (count > 0) {
+        std::size_t lower_count = (count - 1) / 2;
+        int order = name.compare(nameOf(records_[index]));
+        if (order == 0) {
+            return at(index);
+        } else if (order < 0) {
+            index += 1;
+            count = lower_count;
+        } else {
+            index += 1 + lower_count;
+            count -= 1 + lower_count;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+* @param index A record position, below size().
+* @return: A view of the record at that position of the preorder layout.
+*/
+RecipeView RecipeSnapshot::at(std::size_t index) const {
+    const SnapshotRecord& record = records_[index];
+    return RecipeView{nameOf(record), record.difficulty_level,
+                      std::string_view(pool_ + record.description_offset, record.description_length),
+                      record.mastered != 0};
+}
+
+/**
+* @return: Every record position, in name order.
+*/
+std::vector<std::uint32_t> RecipeSnapshot::nameOrder() const {
+    std::vector<std::uint32_t> order;
+    order.reserve(record_count_);
+    visitInNameOrder([&order](std::uint32_t index) {
+        order.push_back(index);
+    });
+    return order;
+}
+
+/**
+* @return: size() record positions, ordered by difficulty level and then name.
+*/
+const std::uint32_t* RecipeSnapshot::difficultyOrder() const {
+    return difficulty_order_;
+}
+
+/**
+* Copies the snapshot out, for RecipeBook::addRecipes.
+* @return: Every Recipe in the snapshot, in name order.
+*/
+std::vector<Recipe> RecipeSnapshot::toRecipes() const {
+    std::vector<Recipe> recipes;
+    recipes.reserve(record_count_);
+    visitInNameOrder([this, &recipes](std::uint32_t index) {
+        RecipeView view = at(index);
+        recipes.emplace_back(std::string(view.name_), view.difficulty_level_, std::string(view.description_), view.mastered_);
+    });
+    return recipes;
+}
+
+/**
+* @param record A record of the mapped file.
+* @return: The record's name, pointing into the pool.
+*/
+std::string_view RecipeSnapshot::nameOf(const SnapshotRecord& record) const {
+    return std::string_view(pool_ + record.name_offset, record.name_length);
+}
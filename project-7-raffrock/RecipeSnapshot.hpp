@@ -0,0 +1,187 @@
+/**
+*@file RecipeSnapshot.hpp
+* Header file for the binary RecipeBook snapshot format: a writer, and a
+reader that maps the file into memory instead of parsing it.
+*/
+
+#ifndef RECIPE_SNAPSHOT_HPP
+#define RECIPE_SNAPSHOT_HPP
+
+#include "RecipeBook.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+* Layout of a snapshot file, version 2, in the byte order of the machine that
+wrote it (the reader rejects a file whose header does not match):
+*   SnapshotHeader
+*   SnapshotRecord[record_count], in the preorder of a perfectly balanced tree
+over the names: each record is the middle of its name range, followed by the
+records of its lower half and then of its upper half. No links are stored,
+since the size of a range gives the position of both halves.
+*   std::uint32_t[record_count]: the record positions ordered by difficulty
+level and then name, so the mapped records can be listed by difficulty
+without sorting.
+*   the string pool: every name and description, each stored once.
+*/
+struct SnapshotHeader
+{
+    char magic[8];               // "RCPSNAP" and a zero byte
+    std::uint32_t version;
+    std::uint32_t record_count;
+    std::uint64_t records_offset;
+    std::uint64_t difficulty_order_offset;
+    std::uint64_t pool_offset;
+    std::uint64_t pool_size;
+};
+
+struct SnapshotRecord
+{
+    std::uint32_t name_offset;         // into the string pool
+    std::uint32_t name_length;
+    std::uint32_t description_offset;  // into the string pool
+    std::uint32_t description_length;
+    std::int32_t difficulty_level;
+    std::uint32_t mastered;            // 0 or 1
+};
+
+/**
+* A Recipe read in place from a snapshot: the strings point into the mapped
+file and stay valid while the RecipeSnapshot that returned it is open.
+*/
+struct RecipeView
+{
+    std::string_view name_;
+    int difficulty_level_;
+    std::string_view description_;
+    bool mastered_;
+};
+
+/**
+* Read-only view of a snapshot file mapped with mmap. Opening it checks the
+header, the bounds of every record and both orders without copying anything;
+lookups binary search the records in place, so nothing is allocated per
+record.
+*/
+class RecipeSnapshot {
+
+public:
+    static constexpr std::uint32_t VERSION = 2;
+
+    /**
+    * Default Constructor.
+    * @post: Initializes a closed snapshot.
+    */
+    RecipeSnapshot();
+
+    /**
+    * Parameterized Constructor.
+    * @param filename The snapshot file to open.
+    * @post: The file is mapped if it is a valid snapshot; check isOpen.
+    */
+    explicit RecipeSnapshot(const std::string& filename);
+
+    // a mapping has one owner
+    RecipeSnapshot(const RecipeSnapshot&) = delete;
+    RecipeSnapshot& operator=(const RecipeSnapshot&) = delete;
+
+    /**
+    * Destructor.
+    * @post: The file is unmapped.
+    */
+    ~RecipeSnapshot();
+
+    /**
+    * Writes a snapshot of a RecipeBook.
+    * @param book The RecipeBook to save.
+    * @param filename The file to create or replace.
+    * @return: True if the whole file was written; false if it could not be
+    written or the strings do not fit 32-bit offsets.
+    */
+    static bool write(const RecipeBook& book, const std::string& filename);
+
+    /**
+    * Maps a snapshot file.
+    * @param filename The snapshot file to open.
+    * @post: Any file open before is closed first.
+    * @return: True if the file was mapped, its header, records and pool are
+    consistent, the records are in name order with no name repeated, and the
+    difficulty order lists every record once in (difficulty_level_, name_)
+    order; false otherwise, leaving the snapshot closed.
+    */
+    bool open(const std::string& filename);
+
+    /**
+    * @post: The file is unmapped; views returned earlier are invalidated.
+    */
+    void close();
+
+    /**
+    * @return: True if a snapshot is mapped.
+    */
+    bool isOpen() const;
+
+    /**
+    * @return: The number of Recipes in the snapshot.
+    */
+    std::size_t size() const;
+
+    /**
+    * Finds a Recipe by name in O(log n), without allocating.
+    * @param name The name of the Recipe.
+    * @return: A view of the Recipe, or nothing if not found.
+    */
+    std::optional<RecipeView> find(std::string_view name) const;
+
+    /**
+    * @param index A record position, below size().
+    * @return: A view of the record at that position of the preorder layout.
+    */
+    RecipeView at(std::size_t index) const;
+
+    /**
+    * @return: Every record position, in name order. Computed from the layout,
+    without comparing any names.
+    */
+    std::vector<std::uint32_t> nameOrder() const;
+
+    /**
+    * @return: size() record positions, ordered by difficulty level and then
+    name, read in place from the mapped file.
+    */
+    const std::uint32_t* difficultyOrder() const;
+
+    /**
+    * Copies the snapshot out, for RecipeBook::addRecipes.
+    * @return: Every Recipe in the snapshot, in name order.
+    */
+    std::vector<Recipe> toRecipes() const;
+
+private:
+    void* mapping_;
+    std::size_t mapping_size_;
+    const SnapshotRecord* records_;
+    const std::uint32_t* difficulty_order_;
+    const char* pool_;
+    std::size_t record_count_;
+
+    /**
+    * @param record A record of the mapped file.
+    * @return: The record's name, pointing into the pool.
+    */
+    std::string_view nameOf(const SnapshotRecord& record) const;
+
+    /**
+    * Walks the records in name order.
+    * @param visit Called with each record position, in name order.
+    */
+    template <class Visit>
+    void visitInNameOrder(Visit visit) const;
+};
+
+#endif
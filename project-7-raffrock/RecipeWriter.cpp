@@ -0,0 +1,227 @@
+/**
+*@file RecipeWriter.cpp
+* Implementation file for RecipeWriter.
+*/
+
+#include "RecipeWriter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+
+#include <unistd.h>
+
+/**
+* Buffer Constructor.
+* @param buffer The memory to render into; it is not null-terminated.
+* @param capacity The size of buffer in bytes.
+* @param format The output format.
+* @post: Recipes are rendered into buffer until it is full.
+*/
+RecipeWriter::RecipeWriter(char* buffer, std::size_t capacity, Format format)
+    : buffer_(buffer), capacity_(capacity), used_(0), file_(nullptr), fd_(-1), format_(format), header_written_(false), good_(true), written_(0) {
+}
+
+/**
+* FILE* Constructor.
+* @param file An open, writable stream; it is flushed but not closed.
+* @param format The output format.
+*/
+RecipeWriter::RecipeWriter(std::FILE* file, Format format)
+    : buffer_(nullptr), capacity_(BLOCK_SIZE), used_(0), block_(new char[BLOCK_SIZE]), file_(file), fd_(-1), format_(format), header_written_(false), good_(true), written_(0) {
+    buffer_ = block_.get();
+}
+
+/**
+* File descriptor Constructor.
+* @param fd An open, writable descriptor; it is not closed.
+* @param format The output format.
+*/
+RecipeWriter::RecipeWriter(int fd, Format format)
+    : buffer_(nullptr), capacity_(BLOCK_SIZE), used_(0), block_(new char[BLOCK_SIZE]), file_(nullptr), fd_(fd), format_(format), header_written_(false), good_(true), written_(0) {
+    buffer_ = block_.get();
+}
+
+/**
+* Destructor.
+* @post: Buffered bytes are flushed to the FILE* or descriptor.
+*/
+RecipeWriter::~RecipeWriter() {
+    flush();
+}
+
+/**
+* Renders one Recipe.
+* @param recipe The Recipe to render.
+* @return: True if it was rendered; false once the destination failed, or for
+a caller buffer without room for the whole Recipe.
+*/
+bool RecipeWriter::write(const Recipe& recipe) {
+    if (!good_) {
+        return false;
+    }
+    // a caller buffer that runs out is cut back to the last complete Recipe
+    std::size_t start = used_;
+    bool header_was_written = header_written_;
+
+    bool rendered = false;
+    switch (format_) {
+    case Format::TEXT:
+        rendered = append("Name: ") && append(recipe.name_)
+            && append("\nDifficulty Level: ") && appendNumber(recipe.difficulty_level_)
+            && append("\nDescription: ") && append(recipe.description_)
+            && append(recipe.mastered_ ? "\nMastered: Yes\n\n" : "\nMastered: No\n\n");
+        break;
+    case Format::TSV:
+        rendered = (header_written_ || append("name\tdifficulty_level\tdescription\tmastered\n"));
+        header_written_ = true;
+        rendered = rendered && appendEscaped(recipe.name_)
+            && append("\t") && appendNumber(recipe.difficulty_level_)
+            && append("\t") && appendEscaped(recipe.description_)
+            && append(recipe.mastered_ ? "\t1\n" : "\t0\n");
+        break;
+    case Format::JSON_LINES:
+        rendered = append("{\"name\":\"") && appendEscaped(recipe.name_)
+            && append("\",\"difficulty_level\":") && appendNumber(recipe.difficulty_level_)
+            && append(",\"description\":\"") && appendEscaped(recipe.description_)
+            && append(recipe.mastered_ ? "\",\"mastered\":true}\n" : "\",\"mastered\":false}\n");
+        break;
+    }
+
+    if (!rendered) {
+        if (block_ == nullptr) {
+            used_ = start;
+            header_written_ = header_was_written;
+        }
+        good_ = false;
+    }
+    return rendered;
+}
+
+/**
+* @post: Buffered bytes are written to the FILE* or descriptor, and a FILE*
+is flushed. Does nothing for a caller buffer.
+* @return: True if every byte so far reached the destination.
+*/
+bool RecipeWriter::flush() {
+    if (block_ == nullptr) {
+        return good_;
+    }
+    if (used_ > 0) {
+        drain();
+    }
+    if (file_ != nullptr && std::fflush(file_) != 0) {
+        good_ = false;
+    }
+    return good_;
+}
+
+/**
+* @return: The number of bytes rendered so far.
+*/
+std::size_t RecipeWriter::size() const {
+    return written_ + used_;
+}
+
+/**
+* @return: False once a write failed or a caller buffer ran out of room.
+*/
+bool RecipeWriter::good() const {
+    return good_;
+}
+
+/**
+* @param text The bytes to add.
+* @return: True if text was buffered, sending full blocks on; false if a
+caller buffer has no room for it.
+*/
+bool RecipeWriter::append(std::string_view text) {
+    while (!text.empty()) {
+        if (used_ == capacity_ && (block_ == nullptr || !drain())) {
+            return false;
+        }
+        std::size_t count = std::min(text.size(), capacity_ - used_);
+        std::memcpy(buffer_ + used_, text.data(), count);
+        used_ += count;
+        text.remove_prefix(count);
+    }
+    return true;
+}
+
+/**
+* @param text A field value.
+* @return: As append, with the characters TSV or JSON cannot hold as-is
+replaced by their escape sequences.
+*/
+bool RecipeWriter::appendEscaped(std::string_view text) {
+    // plain runs are copied in one append, only the special bytes one by one
+    std::size_t run_start = 0;
+    for (std::size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        const char* escape = nullptr;
+        char control[7];
+        if (c == '\t') {
+            escape = "\\t";
+        } else if (c == '\n') {
+            escape = "\\n";
+        } else if (c == '\r') {
+            escape = "\\r";
+        } else if (c == '\\') {
+            escape = "\\\\";
+        } else if (format_ == Format::JSON_LINES && c == '"') {
+            escape = "\\\"";
+        } else if (format_ == Format::JSON_LINES && c < 0x20) {
+            std::snprintf(control, sizeof(control), "\\u%04x", c);
+            escape = control;
+        }
+        if (escape == nullptr) {
+            continue;
+        }
+        if (!append(text.substr(run_start, i - run_start)) || !append(escape)) {
+            return false;
+        }
+        run_start = i + 1;
+    }
+    return append(text.substr(run_start));
+}
+
+/**
+* @param value A number to format in decimal.
+* @return: As append.
+*/
+bool RecipeWriter::appendNumber(int value) {
+    char digits[16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    return append(std::string_view(digits, result.ptr - digits));
+}
+
+/**
+* @post: block_ is sent to the FILE* or descriptor and emptied.
+* @return: True if every byte was written.
+*/
+bool RecipeWriter::drain() {
+    bool sent_all = true;
+    if (file_ != nullptr) {
+        sent_all = std::fwrite(buffer_, 1, used_, file_) == used_;
+    } else {
+        std::size_t sent = 0;
+        while (sent < used_) {
+            ssize_t count = ::write(fd_, buffer_ + sent, used_ - sent);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                sent_all = false;
+                break;
+            }
+            sent += static_cast<std::size_t>(count);
+        }
+    }
+    written_ += used_;
+    used_ = 0;
+    if (!sent_all) {
+        good_ = false;
+    }
+    return sent_all;
+}
@@ -0,0 +1,139 @@
+/**
+*@file RecipeWriter.hpp
+* Header file for RecipeWriter, a buffered sink that renders Recipes as text,
+TSV or JSON lines without copying them.
+*/
+
+#ifndef RECIPE_WRITER_HPP
+#define RECIPE_WRITER_HPP
+
+#include "RecipeBook.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string_view>
+
+/**
+* Renders Recipes into one of three destinations:
+*   a caller-provided buffer, filled in place and never grown;
+*   a FILE*, or a file descriptor, written in BLOCK_SIZE blocks.
+* Fields are formatted straight into the buffer, so rendering a Recipe
+allocates nothing. The block of a FILE* or descriptor sink is allocated
+once, when the writer is made.
+*/
+class RecipeWriter {
+
+public:
+    /**
+    * TEXT: the preorderDisplay format, a "Field: value" line per field and an
+    empty line after each Recipe.
+    * TSV: a header row, then name, difficulty_level, description and
+    mastered (0 or 1) separated by tabs, with tab, newline, carriage return
+    and backslash escaped as \t, \n, \r and \\.
+    * JSON_LINES: one JSON object per line.
+    */
+    enum class Format { TEXT, TSV, JSON_LINES };
+
+    static constexpr std::size_t BLOCK_SIZE = 1 << 16;
+
+    /**
+    * Buffer Constructor.
+    * @param buffer The memory to render into; it is not null-terminated.
+    * @param capacity The size of buffer in bytes.
+    * @param format The output format.
+    * @post: Recipes are rendered into buffer until it is full.
+    */
+    RecipeWriter(char* buffer, std::size_t capacity, Format format = Format::TEXT);
+
+    /**
+    * FILE* Constructor.
+    * @param file An open, writable stream; it is flushed but not closed.
+    * @param format The output format.
+    */
+    explicit RecipeWriter(std::FILE* file, Format format = Format::TEXT);
+
+    /**
+    * File descriptor Constructor.
+    * @param fd An open, writable descriptor; it is not closed.
+    * @param format The output format.
+    */
+    explicit RecipeWriter(int fd, Format format = Format::TEXT);
+
+    // one writer per destination, so buffered bytes are written once
+    RecipeWriter(const RecipeWriter&) = delete;
+    RecipeWriter& operator=(const RecipeWriter&) = delete;
+
+    /**
+    * Destructor.
+    * @post: Buffered bytes are flushed to the FILE* or descriptor.
+    */
+    ~RecipeWriter();
+
+    /**
+    * Renders one Recipe.
+    * @param recipe The Recipe to render.
+    * @return: True if it was rendered. False once the destination failed, or
+    for a caller buffer without room for the whole Recipe; the buffer then
+    still ends at the last complete Recipe.
+    */
+    bool write(const Recipe& recipe);
+
+    /**
+    * @post: Buffered bytes are written to the FILE* or descriptor, and a
+    FILE* is flushed. Does nothing for a caller buffer.
+    * @return: True if every byte so far reached the destination.
+    */
+    bool flush();
+
+    /**
+    * @return: The number of bytes rendered so far. For a caller buffer, this
+    is the length of its valid contents.
+    */
+    std::size_t size() const;
+
+    /**
+    * @return: False once a write failed or a caller buffer ran out of room.
+    */
+    bool good() const;
+
+private:
+    char* buffer_;                   // the caller's buffer, or block_
+    std::size_t capacity_;
+    std::size_t used_;               // bytes of buffer_ in use
+    std::unique_ptr<char[]> block_;  // for FILE* and descriptor sinks
+    std::FILE* file_;
+    int fd_;
+    Format format_;
+    bool header_written_;
+    bool good_;
+    std::size_t written_;            // bytes already sent to the destination
+
+    /**
+    * @param text The bytes to add.
+    * @return: True if text was buffered, sending full blocks on; false if a
+    caller buffer has no room for it.
+    */
+    bool append(std::string_view text);
+
+    /**
+    * @param text A field value.
+    * @return: As append, with the characters TSV or JSON cannot hold as-is
+    replaced by their escape sequences.
+    */
+    bool appendEscaped(std::string_view text);
+
+    /**
+    * @param value A number to format in decimal.
+    * @return: As append.
+    */
+    bool appendNumber(int value);
+
+    /**
+    * @post: block_ is sent to the FILE* or descriptor and emptied.
+    * @return: True if every byte was written.
+    */
+    bool drain();
+};
+
+#endif
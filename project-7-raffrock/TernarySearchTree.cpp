@@ -0,0 +1,328 @@
+/**
+*@file TernarySearchTree.cpp
+* Implementation file for TernarySearchTree.
+*/
+
+#include "TernarySearchTree.hpp"
+
+#include <algorithm>
+
+/**
+* Default Constructor.
+* @post: Initializes an empty tree.
+*/
+TernarySearchTree::TernarySearchTree() : root_(NULL_INDEX), word_count_(0), free_list_(NULL_INDEX) {
+}
+
+/**
+* @param word The word to add; empty words are ignored.
+* @post: word is in the set.
+* @return: True if word was added; false if it was already there or empty.
+*/
+bool TernarySearchTree::insert(std::string_view word) {
+    if (word.empty()) {
+        return false;
+    }
+    if (root_ == NULL_INDEX) {
+        root_ = newNode(static_cast<unsigned char>(word[0]));
+    }
+
+    // missing nodes are created as the walk reaches them; links are written
+    // through indices because newNode may move the nodes
+    std::uint32_t current = root_;
+    std::size_t position = 0;
+    while (true) {
+        unsigned char ch = static_cast<unsigned char>(word[position]);
+        if (ch < nodes_[current].ch) {
+            if (nodes_[current].lo == NULL_INDEX) {
+                std::uint32_t created = newNode(ch);
+                nodes_[current].lo = created;
+            }
+            current = nodes_[current].lo;
+        } else if (ch > nodes_[current].ch) {
+            if (nodes_[current].hi == NULL_INDEX) {
+                std::uint32_t created = newNode(ch);
+                nodes_[current].hi = created;
+            }
+            current = nodes_[current].hi;
+        } else if (position + 1 == word.size()) {
+            if (nodes_[current].is_end) {
+                return false;
+            }
+            nodes_[current].is_end = true;
+            word_count_++;
+            return true;
+        } else {
+            position++;
+            if (nodes_[current].eq == NULL_INDEX) {
+                std::uint32_t created = newNode(static_cast<unsigned char>(word[position]));
+                nodes_[current].eq = created;
+            }
+            current = nodes_[current].eq;
+        }
+    }
+}
+
+/**
+* @param word The word to remove.
+* @post: word is not in the set. Nodes that no longer lead to any word are
+unlinked and kept for reuse.
+* @return: True if word was removed; false if it was not there.
+*/
+bool TernarySearchTree::remove(std::string_view word) {
+    if (word.empty()) {
+        return false;
+    }
+
+    // the link followed to reach each node of the walk, root first
+    std::vector<std::uint32_t*> links;
+    std::uint32_t* link = &root_;
+    std::size_t position = 0;
+    while (*link != NULL_INDEX) {
+        links.push_back(link);
+        Node& node = nodes_[*link];
+        unsigned char ch = static_cast<unsigned char>(word[position]);
+        if (ch < node.ch) {
+            link = &node.lo;
+        } else if (ch > node.ch) {
+            link = &node.hi;
+        } else if (position + 1 == word.size()) {
+            break;
+        } else {
+            position++;
+            link = &node.eq;
+        }
+    }
+    if (*link == NULL_INDEX || !nodes_[*link].is_end) {
+        return false;
+    }
+    nodes_[*link].is_end = false;
+    word_count_--;
+
+    // back up the walk: a node that ends no word and has nothing below it
+    // goes, and one with a single sibling subtree is replaced by it. A node
+    // with both siblings stays; the walk stops at the first node kept
+    for (std::size_t i = links.size(); i-- > 0;) {
+        std::uint32_t index = *links[i];
+        const Node& node = nodes_[index];
+        if (node.is_end || node.eq != NULL_INDEX || (node.lo != NULL_INDEX && node.hi != NULL_INDEX)) {
+            break;
+        }
+        *links[i] = (node.lo != NULL_INDEX) ? node.lo : node.hi;
+        freeNode(index);
+    }
+    return true;
+}
+
+/**
+* @param word The word to find.
+* @return: True if word is in the set.
+*/
+bool TernarySearchTree::contains(std::string_view word) const {
+    if (word.empty()) {
+        return false;
+    }
+    std::uint32_t node = findNode(word);
+    return node != NULL_INDEX && nodes_[node].is_end;
+}
+
+/**
+* Prefix completion.
+* @param prefix The start of the words to find.
+* @param limit The most words to return.
+* @return: Up to limit words starting with prefix, in ascending order.
+*/
+std::vector<std::string> TernarySearchTree::complete(std::string_view prefix, std::size_t limit) const {
+    std::vector<std::string> words;
+    if (limit == 0) {
+        return words;
+    }
+
+    std::string word(prefix);
+    std::uint32_t start = root_;
+    if (!prefix.empty()) {
+        std::uint32_t prefix_node = findNode(prefix);
+        if (prefix_node == NULL_INDEX) {
+            return words;
+        }
+        if (nodes_[prefix_node].is_end) {
+            words.push_back(word);
+        }
+        start = nodes_[prefix_node].eq;
+    }
+
+    // inorder walk of the subtree: lo, then the node's own word, then eq, then hi.
+    // An entry at depth d needs word[0..d) to be its path, which holds because
+    // each subtree is finished before anything pushed earlier is popped
+    struct Step
+    {
+        std::uint32_t node;
+        std::size_t depth;
+        bool emit; // the node's lo subtree is done: emit its word, move below it
+    };
+    std::vector<Step> steps;
+    if (start != NULL_INDEX) {
+        steps.push_back(Step{start, prefix.size(), false});
+    }
+    while (!steps.empty() && words.size() < limit) {
+        Step step = steps.back();
+        steps.pop_back();
+        const Node& node = nodes_[step.node];
+        if (step.emit) {
+            word.resize(step.depth);
+            word += static_cast<char>(node.ch);
+            if (node.is_end) {
+                words.push_back(word);
+            }
+            continue;
+        }
+        if (node.hi != NULL_INDEX) {
+            steps.push_back(Step{node.hi, step.depth, false});
+        }
+        if (node.eq != NULL_INDEX) {
+            steps.push_back(Step{node.eq, step.depth + 1, false});
+        }
+        steps.push_back(Step{step.node, step.depth, true});
+        if (node.lo != NULL_INDEX) {
+            steps.push_back(Step{node.lo, step.depth, false});
+        }
+    }
+    return words;
+}
+
+/**
+* Bounded edit-distance search.
+* @param word The word to match, possibly misspelled.
+* @param max_distance The largest Levenshtein distance to accept.
+* @return: (word, distance) for every word within max_distance edits of word,
+closest first and then in ascending order.
+*/
+std::vector<std::pair<std::string, int>> TernarySearchTree::findWithin(std::string_view word, int max_distance) const {
+    std::vector<std::pair<std::string, int>> matches;
+    if (root_ == NULL_INDEX || max_distance < 0) {
+        return matches;
+    }
+
+    // rows[d][j] is the edit distance between the first d characters of the
+    // current path and the first j characters of word. A node at depth d reads
+    // rows[d] and writes rows[d + 1]; its eq subtree is finished before its
+    // lo and hi siblings (which rewrite rows[d + 1]) are popped
+    const std::size_t columns = word.size() + 1;
+    std::vector<std::vector<int>> rows(1, std::vector<int>(columns));
+    for (std::size_t j = 0; j < columns; j++) {
+        rows[0][j] = static_cast<int>(j);
+    }
+    std::string path;
+
+    std::vector<std::pair<std::uint32_t, std::size_t>> steps; // (node, depth)
+    steps.push_back({root_, 0});
+    while (!steps.empty()) {
+        std::uint32_t index = steps.back().first;
+        std::size_t depth = steps.back().second;
+        steps.pop_back();
+        const Node& node = nodes_[index];
+
+        // siblings share this node's parent row, so they are always visited
+        if (node.hi != NULL_INDEX) {
+            steps.push_back({node.hi, depth});
+        }
+        if (node.lo != NULL_INDEX) {
+            steps.push_back({node.lo, depth});
+        }
+
+        if (rows.size() < depth + 2) {
+            rows.resize(depth + 2, std::vector<int>(columns));
+        }
+        const std::vector<int>& above = rows[depth];
+        std::vector<int>& row = rows[depth + 1];
+        row[0] = above[0] + 1;
+        int row_min = row[0];
+        for (std::size_t j = 1; j < columns; j++) {
+            int substitute = above[j - 1] + (static_cast<unsigned char>(word[j - 1]) == node.ch ? 0 : 1);
+            row[j] = std::min({above[j] + 1, row[j - 1] + 1, substitute});
+            row_min = std::min(row_min, row[j]);
+        }
+
+        path.resize(depth);
+        path += static_cast<char>(node.ch);
+        if (node.is_end && row[columns - 1] <= max_distance) {
+            matches.push_back({path, row[columns - 1]});
+        }
+        // no cell within reach: every longer path only adds edits
+        if (row_min <= max_distance && node.eq != NULL_INDEX) {
+            steps.push_back({node.eq, depth + 1});
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    });
+    return matches;
+}
+
+/**
+* @post: The set is emptied and its nodes are released.
+*/
+void TernarySearchTree::clear() {
+    nodes_.clear();
+    root_ = NULL_INDEX;
+    word_count_ = 0;
+    free_list_ = NULL_INDEX;
+}
+
+/**
+* @return: The number of words in the set.
+*/
+std::size_t TernarySearchTree::size() const {
+    return word_count_;
+}
+
+/**
+* @param word A non-empty word.
+* @return: The index of the node of the last character of word, or NULL_INDEX
+if no word has it as a prefix.
+*/
+std::uint32_t TernarySearchTree::findNode(std::string_view word) const {
+    std::uint32_t current = root_;
+    std::size_t position = 0;
+    while (current != NULL_INDEX) {
+        const Node& node = nodes_[current];
+        unsigned char ch = static_cast<unsigned char>(word[position]);
+        if (ch < node.ch) {
+            current = node.lo;
+        } else if (ch > node.ch) {
+            current = node.hi;
+        } else if (position + 1 == word.size()) {
+            return current;
+        } else {
+            position++;
+            current = node.eq;
+        }
+    }
+    return NULL_INDEX;
+}
+
+/**
+* @param ch The character of the new node.
+* @return: The index of a new node with no children that ends no word, taken
+from free_list_ when it has one.
+*/
+std::uint32_t TernarySearchTree::newNode(unsigned char ch) {
+    if (free_list_ != NULL_INDEX) {
+        std::uint32_t index = free_list_;
+        free_list_ = nodes_[index].eq;
+        nodes_[index] = Node{ch, false, NULL_INDEX, NULL_INDEX, NULL_INDEX};
+        return index;
+    }
+    nodes_.push_back(Node{ch, false, NULL_INDEX, NULL_INDEX, NULL_INDEX});
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+/**
+* @param index An unlinked node.
+* @post: The node is put on free_list_.
+*/
+void TernarySearchTree::freeNode(std::uint32_t index) {
+    nodes_[index].eq = free_list_;
+    free_list_ = index;
+}
@@ -0,0 +1,128 @@
+/**
+*@file TernarySearchTree.hpp
+* Header file for TernarySearchTree, the name index RecipeBook uses for
+prefix completion and typo-tolerant lookups.
+*/
+
+#ifndef TERNARY_SEARCH_TREE_HPP
+#define TERNARY_SEARCH_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+* Set of strings stored one character per node. Each node has a lo and hi
+child for other characters at the same position and an eq child for the
+next position, so words sharing a prefix share its nodes.
+* Nodes live in one std::vector, linked by 32-bit indices. Walks use explicit
+stacks, so long names cannot overflow the call stack. Nodes left without a
+word are unlinked by remove and their slots reused, so add/remove churn
+keeps the vector proportional to the words in the set.
+* A TST is only as shallow as its lo/hi sibling lists are balanced: inserting
+words in sorted order turns each list into a chain. Bulk loads should insert
+the median word first, then the medians of each half.
+* Characters compare as unsigned char, like std::string, so completions come
+out in the same order as RecipeBook's names.
+*/
+class TernarySearchTree {
+
+public:
+    /**
+    * Default Constructor.
+    * @post: Initializes an empty tree.
+    */
+    TernarySearchTree();
+
+    /**
+    * @param word The word to add; empty words are ignored.
+    * @post: word is in the set.
+    * @return: True if word was added; false if it was already there or empty.
+    */
+    bool insert(std::string_view word);
+
+    /**
+    * @param word The word to remove.
+    * @post: word is not in the set. Nodes that no longer lead to any word
+    are unlinked and kept for reuse by insert.
+    * @return: True if word was removed; false if it was not there.
+    */
+    bool remove(std::string_view word);
+
+    /**
+    * @param word The word to find.
+    * @return: True if word is in the set.
+    */
+    bool contains(std::string_view word) const;
+
+    /**
+    * Prefix completion.
+    * @param prefix The start of the words to find; empty matches every word.
+    * @param limit The most words to return.
+    * @return: Up to limit words starting with prefix, in ascending order.
+    */
+    std::vector<std::string> complete(std::string_view prefix, std::size_t limit) const;
+
+    /**
+    * Bounded edit-distance search.
+    * @param word The word to match, possibly misspelled.
+    * @param max_distance The largest Levenshtein distance to accept.
+    * @return: (word, distance) for every word within max_distance edits of
+    word, closest first and then in ascending order. One row of the edit
+    distance table is computed per node visited, and a subtree is skipped as
+    soon as every cell of its row exceeds max_distance.
+    */
+    std::vector<std::pair<std::string, int>> findWithin(std::string_view word, int max_distance) const;
+
+    /**
+    * @post: The set is emptied and its nodes are released.
+    */
+    void clear();
+
+    /**
+    * @return: The number of words in the set.
+    */
+    std::size_t size() const;
+
+private:
+    static constexpr std::uint32_t NULL_INDEX = 0xFFFFFFFFu;
+
+    struct Node
+    {
+        unsigned char ch;
+        bool is_end;         // a word ends at this node
+        std::uint32_t lo;    // words with a smaller character here
+        std::uint32_t eq;    // the next character of words with this one here
+        std::uint32_t hi;    // words with a larger character here
+    };
+
+    std::vector<Node> nodes_;
+    std::uint32_t root_;
+    std::size_t word_count_;
+    std::uint32_t free_list_; // unlinked nodes, chained through eq
+
+    /**
+    * @param word A non-empty word.
+    * @return: The index of the node of the last character of word, or
+    NULL_INDEX if no word has it as a prefix.
+    */
+    std::uint32_t findNode(std::string_view word) const;
+
+    /**
+    * @param ch The character of the new node.
+    * @return: The index of a new node with no children that ends no word,
+    taken from free_list_ when it has one.
+    */
+    std::uint32_t newNode(unsigned char ch);
+
+    /**
+    * @param index An unlinked node.
+    * @post: The node is put on free_list_.
+    */
+    void freeNode(std::uint32_t index);
+};
+
+#endif
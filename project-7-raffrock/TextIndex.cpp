@@ -0,0 +1,253 @@
+/**
+*@file TextIndex.cpp
+* Implementation file for TextIndex.
+*/
+
+#include "TextIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+/**
+* Default Constructor.
+* @post: Initializes an empty index.
+*/
+TextIndex::TextIndex() : removed_count_(0) {
+}
+
+/**
+* Adds a document.
+* @param name The name of the document, not already in the index.
+* @param text The text whose words are indexed.
+* @post: Every word of text now lists the document.
+*/
+void TextIndex::addDocument(const std::string& name, std::string_view text) {
+    if (names_.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("TextIndex: too many documents");
+    }
+    std::uint32_t id = static_cast<std::uint32_t>(names_.size());
+    names_.push_back(name);
+    removed_.push_back(false);
+    ids_.emplace(name, id);
+    // id is larger than every id already indexed, so appending keeps each list sorted
+    for (std::string& word : tokenize(text)) {
+        postings_[std::move(word)].push_back(id);
+    }
+}
+
+/**
+* Removes a document.
+* @param name The name of the document.
+* @post: No query finds the document anymore.
+* @return: True if the document was in the index; false otherwise.
+*/
+bool TextIndex::removeDocument(const std::string& name) {
+    auto id_it = ids_.find(name);
+    if (id_it == ids_.end()) {
+        return false;
+    }
+    std::uint32_t id = id_it->second;
+    // the id stays in its posting lists until compact; dropRemoved skips it
+    removed_[id] = true;
+    removed_count_++;
+    names_[id] = std::string();
+    ids_.erase(id_it);
+    if (removed_count_ > ids_.size()) {
+        compact();
+    }
+    return true;
+}
+
+/**
+* @param query One or more words.
+* @return: The ids of the documents containing every word of query, ascending.
+*/
+std::vector<std::uint32_t> TextIndex::findAll(std::string_view query) const {
+    std::vector<const std::vector<std::uint32_t>*> lists = postingsFor(query);
+    if (lists.empty()) {
+        return {};
+    }
+    for (const std::vector<std::uint32_t>* list : lists) {
+        if (list == nullptr) {
+            // a word nobody uses: nothing can contain every word
+            return {};
+        }
+    }
+
+    // start from the shortest list so every step shrinks the candidates fastest
+    std::sort(lists.begin(), lists.end(), [](const std::vector<std::uint32_t>* a, const std::vector<std::uint32_t>* b) {
+        return a->size() < b->size();
+    });
+    std::vector<std::uint32_t> result = *lists.front();
+    for (std::size_t i = 1; i < lists.size() && !result.empty(); i++) {
+        const std::vector<std::uint32_t>& longer = *lists[i];
+        // gallop through the longer list: each candidate is a binary search
+        // from where the previous one stopped, so a short list against a
+        // long one costs O(short * log long) instead of O(long)
+        std::size_t kept = 0;
+        auto from = longer.begin();
+        for (std::uint32_t id : result) {
+            from = std::lower_bound(from, longer.end(), id);
+            if (from == longer.end()) {
+                break;
+            }
+            if (*from == id) {
+                result[kept++] = id;
+            }
+        }
+        result.resize(kept);
+    }
+    dropRemoved(result);
+    return result;
+}
+
+/**
+* @param query One or more words.
+* @return: The ids of the documents containing at least one word of query,
+ascending.
+*/
+std::vector<std::uint32_t> TextIndex::findAny(std::string_view query) const {
+    std::vector<std::uint32_t> result;
+    std::vector<std::uint32_t> merged;
+    for (const std::vector<std::uint32_t>* list : postingsFor(query)) {
+        if (list == nullptr) {
+            continue;
+        }
+        merged.clear();
+        std::set_union(result.begin(), result.end(), list->begin(), list->end(), std::back_inserter(merged));
+        result.swap(merged);
+    }
+    dropRemoved(result);
+    return result;
+}
+
+/**
+* @param id An id returned by findAll or findAny since the last change.
+* @return: The name of that document.
+*/
+const std::string& TextIndex::nameOf(std::uint32_t id) const {
+    return names_[id];
+}
+
+/**
+* @post: The index is emptied, and ids start over.
+*/
+void TextIndex::clear() {
+    postings_.clear();
+    ids_.clear();
+    names_.clear();
+    removed_.clear();
+    removed_count_ = 0;
+}
+
+/**
+* @param documents How many documents the index will hold.
+* @post: Adding up to that many documents does not regrow the id tables.
+*/
+void TextIndex::reserve(std::size_t documents) {
+    ids_.reserve(documents);
+    names_.reserve(documents);
+    removed_.reserve(documents);
+}
+
+/**
+* @return: The number of documents in the index.
+*/
+std::size_t TextIndex::size() const {
+    return ids_.size();
+}
+
+/**
+* @post: Removed ids are dropped from every posting list, and the live
+documents are renumbered 0, 1, ... in the order they were added.
+*/
+void TextIndex::compact() {
+    // renumbering keeps the order of the live ids, so lists stay sorted
+    std::vector<std::uint32_t> new_ids(names_.size());
+    std::uint32_t next_id = 0;
+    for (std::size_t id = 0; id < names_.size(); id++) {
+        if (!removed_[id]) {
+            if (next_id != id) {
+                names_[next_id] = std::move(names_[id]);
+            }
+            new_ids[id] = next_id++;
+        }
+    }
+
+    for (auto posting_it = postings_.begin(); posting_it != postings_.end();) {
+        std::vector<std::uint32_t>& ids = posting_it->second;
+        std::size_t kept = 0;
+        for (std::uint32_t id : ids) {
+            if (!removed_[id]) {
+                ids[kept++] = new_ids[id];
+            }
+        }
+        if (kept == 0) {
+            posting_it = postings_.erase(posting_it);
+            continue;
+        }
+        ids.resize(kept);
+        ++posting_it;
+    }
+    for (auto& entry : ids_) {
+        entry.second = new_ids[entry.second];
+    }
+
+    names_.resize(next_id);
+    removed_.assign(next_id, false);
+    removed_count_ = 0;
+}
+
+/**
+* Splits text into its distinct words.
+* @param text The text to split.
+* @return: The lowercased words of text, each once, in order of first
+appearance.
+*/
+std::vector<std::string> TextIndex::tokenize(std::string_view text) {
+    std::vector<std::string> words;
+    std::string word;
+    for (std::size_t i = 0; i <= text.size(); i++) {
+        char c = i < text.size() ? text[i] : ' ';
+        bool is_word_char = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        if (is_word_char) {
+            word += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        } else if (!word.empty()) {
+            // descriptions are short, a linear check for repeats is cheapest
+            if (std::find(words.begin(), words.end(), word) == words.end()) {
+                words.push_back(word);
+            }
+            word.clear();
+        }
+    }
+    return words;
+}
+
+/**
+* @param query One or more words.
+* @return: The posting list of every distinct word of query, nullptr for a
+word no document contains.
+*/
+std::vector<const std::vector<std::uint32_t>*> TextIndex::postingsFor(std::string_view query) const {
+    std::vector<const std::vector<std::uint32_t>*> lists;
+    for (const std::string& word : tokenize(query)) {
+        auto posting_it = postings_.find(word);
+        lists.push_back(posting_it == postings_.end() ? nullptr : &posting_it->second);
+    }
+    return lists;
+}
+
+/**
+* @param ids Ascending ids.
+* @post: The ids of removed documents are dropped, in place.
+*/
+void TextIndex::dropRemoved(std::vector<std::uint32_t>& ids) const {
+    if (removed_count_ == 0) {
+        return;
+    }
+    ids.erase(std::remove_if(ids.begin(), ids.end(), [this](std::uint32_t id) {
+        return removed_[id];
+    }), ids.end());
+}
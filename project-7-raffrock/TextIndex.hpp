@@ -0,0 +1,132 @@
+/**
+*@file TextIndex.hpp
+* Header file for TextIndex, an inverted keyword index used by RecipeBook to
+search Recipe descriptions.
+*/
+
+#ifndef TEXT_INDEX_HPP
+#define TEXT_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Inverted index from words to the documents containing them.
+* A document is a name (a Recipe's name_) and a text (its description_).
+Each document gets an integer id when it is added; ids only grow, so every
+posting list is a sorted std::vector of ids that new documents are appended
+to. A query looks up one posting list per word and intersects (AND) or
+merges (OR) them, without touching any text, and returns ids: a caller reads
+the names it needs through nameOf, so a broad query copies no strings.
+* Removing a document only marks its id as removed, and queries skip removed
+ids. Once removed ids outnumber live ones, compact drops them from every
+posting list and renumbers the live documents in order, so ids stay below
+twice the number of documents and removals never shift a posting list.
+* Words are maximal runs of ASCII letters and digits, lowercased.
+*/
+class TextIndex {
+
+public:
+    /**
+    * Default Constructor.
+    * @post: Initializes an empty index.
+    */
+    TextIndex();
+
+    /**
+    * Adds a document.
+    * @param name The name of the document, not already in the index.
+    * @param text The text whose words are indexed.
+    * @post: Every word of text now lists the document.
+    */
+    void addDocument(const std::string& name, std::string_view text);
+
+    /**
+    * Removes a document.
+    * @param name The name of the document.
+    * @post: No query finds the document anymore.
+    * @return: True if the document was in the index; false otherwise.
+    */
+    bool removeDocument(const std::string& name);
+
+    /**
+    * @param query One or more words.
+    * @return: The ids of the documents containing every word of query,
+    ascending, which is the order they were added. Empty if query has no
+    words. Ids are invalidated by the next addDocument or removeDocument.
+    */
+    std::vector<std::uint32_t> findAll(std::string_view query) const;
+
+    /**
+    * @param query One or more words.
+    * @return: The ids of the documents containing at least one word of query,
+    ascending.
+    */
+    std::vector<std::uint32_t> findAny(std::string_view query) const;
+
+    /**
+    * @param id An id returned by findAll or findAny since the last change.
+    * @return: The name of that document.
+    */
+    const std::string& nameOf(std::uint32_t id) const;
+
+    /**
+    * @post: The index is emptied, and ids start over.
+    */
+    void clear();
+
+    /**
+    * @param documents How many documents the index will hold.
+    * @post: Adding up to that many documents does not regrow the id tables.
+    */
+    void reserve(std::size_t documents);
+
+    /**
+    * @return: The number of documents in the index.
+    */
+    std::size_t size() const;
+
+    /**
+    * Splits text into its distinct words.
+    * @param text The text to split.
+    * @return: The lowercased words of text, each once, in order of first
+    appearance.
+    */
+    static std::vector<std::string> tokenize(std::string_view text);
+
+private:
+    // word -> ids of the documents containing it, ascending
+    std::unordered_map<std::string, std::vector<std::uint32_t>> postings_;
+    // name -> id of each document in the index
+    std::unordered_map<std::string, std::uint32_t> ids_;
+    // id -> name; the slot of a removed document is left empty
+    std::vector<std::string> names_;
+    // id -> true if the document was removed since the last compact
+    std::vector<bool> removed_;
+    std::size_t removed_count_;
+
+    /**
+    * @post: Removed ids are dropped from every posting list, and the live
+    documents are renumbered 0, 1, ... in the order they were added.
+    */
+    void compact();
+
+    /**
+    * @param query One or more words.
+    * @return: The posting list of every distinct word of query, nullptr for a
+    word no document contains.
+    */
+    std::vector<const std::vector<std::uint32_t>*> postingsFor(std::string_view query) const;
+
+    /**
+    * @param ids Ascending ids.
+    * @post: The ids of removed documents are dropped, in place.
+    */
+    void dropRemoved(std::vector<std::uint32_t>& ids) const;
+};
+
+#endif
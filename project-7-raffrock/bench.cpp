@@ -0,0 +1,772 @@
+/**
+*@file bench.cpp
+* Benchmarks for RecipeBook and the tree containers under it.
+* Usage: recipe_bench [max_n]
+* Prints CSV (benchmark,container,shape,n,height,ns_per_op,bytes_per_node,allocs_per_op)
+to stdout so runs can be compared.
+*   suite_*: every RecipeBook operation on synthetic books of 1k, 10k, ... up
+to max_n recipes (1M by default, pass 10000000 for the full range), one row
+per operation, shape and size, for RecipeBook and again for BTreeRecipeBook.
+See makeWorkload for the shapes.
+*   lookup: findRecipe cost should follow the height column, not n.
+*   mastery_points: calculateMasteryPoints, should follow height like lookup.
+*   mastery_report: calculateAllMasteryPoints, per recipe; should stay flat in n.
+*   frozen_lookup: FrozenRecipeBook::findRecipe on a snapshot of the same book.
+*   text_search: TextIndex AND / OR queries of two words over 1M descriptions.
+*   node_store: shared_ptr nodes against the NodeArena and the B-tree at 1M nodes.
+*   bulk_build / copy: buildFromSorted and the copy constructor, per node; both
+split large trees across hardware threads.
+*   render: RecipeBook::renderPreorder into /dev/null, per recipe, in each
+RecipeWriter format; bytes_per_node is the output size per recipe.
+*   csv_load: a 500k-row CSV export into an empty RecipeBook, per row; a load
+over one second in total is reported on stderr.
+*   snapshot_load: from a file to a usable RecipeBook, per recipe, for a CSV
+and for a snapshot of it. snapshot_open is only mapping and checking the
+snapshot, and snapshot_find is lookups in the mapped snapshot.
+*   published: RecipeBook::setPublishing, then remove_add and set_mastered on
+the publishing book, per operation, alone (shape idle) and while reader
+threads search publishedRecipes (shape readers). published_find is the
+readers' lookups, per lookup across all readers. The readers check every
+version they take, so a torn publish is reported.
+*/
+
+#include "RecipeBook.hpp"
+#include "FrozenRecipeBook.hpp"
+#include "ArenaBinarySearchTree.hpp"
+#include "BTree.hpp"
+#include "TextIndex.hpp"
+#include "RecipeSnapshot.hpp"
+#include "RecipeWriter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// every heap allocation made by the program goes through here, so a case can
+// report how many bytes its container holds. Each block carries its size in a
+// header so live_bytes also goes down when memory is freed.
+static std::atomic<std::size_t> live_bytes(0);
+static std::atomic<std::size_t> allocation_count(0);
+static const std::size_t HEADER_BYTES = alignof(std::max_align_t);
+
+void* operator new(std::size_t size) {
+    char* block = static_cast<char*>(std::malloc(size + HEADER_BYTES));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    live_bytes += size;
+    allocation_count++;
+    return block + HEADER_BYTES;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    char* block = static_cast<char*>(ptr) - HEADER_BYTES;
+    live_bytes -= *reinterpret_cast<std::size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+
+// long enough that copying a Recipe has to allocate
+const char* const DESCRIPTION = "Simmer gently until the sauce coats the back of a spoon.";
+
+using Clock = std::chrono::steady_clock;
+
+/**
+* @return nanoseconds elapsed since start
+*/
+double nanosSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+* @param count how many names to generate
+* @return names "recipe00000000" ... in sorted order
+*/
+std::vector<std::string> makeNames(int count) {
+    std::vector<std::string> names;
+    names.reserve(count);
+    char buffer[32];
+    for (int i = 0; i < count; i++) {
+        std::snprintf(buffer, sizeof(buffer), "recipe%08d", i);
+        names.push_back(buffer);
+    }
+    return names;
+}
+
+/**
+* @return count random indices into names
+*/
+std::vector<int> sampleIndices(const std::vector<std::string>& names, int count, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(names.size()) - 1);
+    std::vector<int> sample(count);
+    for (int& index : sample) {
+        index = pick(rng);
+    }
+    return sample;
+}
+
+void printRow(const char* benchmark, const char* container, const char* shape, std::size_t n, int height, double ns_per_op, double bytes_per_node, double allocs_per_op) {
+    std::printf("%s,%s,%s,%zu,%d,%.1f,%.1f,%.2f\n", benchmark, container, shape, n, height, ns_per_op, bytes_per_node, allocs_per_op);
+}
+
+/**
+* Makes a book build every index it builds on first use, so the timings after
+it are of using and maintaining the indexes, not of building them.
+*/
+template <class Book>
+void buildIndexes(const Book& book) {
+    book.countRecipesByDifficulty(0, 0);
+    book.completeName("", 1);
+    book.searchDescriptions("");
+}
+
+/**
+* Times findRecipe on a book built in the given insertion order.
+*/
+void lookupCase(const char* shape, const std::vector<std::string>& names, const std::vector<std::string>& insert_order, std::mt19937& rng) {
+    std::size_t bytes_before = live_bytes;
+    RecipeBook book;
+    for (std::size_t i = 0; i < insert_order.size(); i++) {
+        book.addRecipe(Recipe(insert_order[i], i % 10, DESCRIPTION, i % 3 == 0));
+    }
+    buildIndexes(book);
+    double bytes_per_node = double(live_bytes - bytes_before) / names.size();
+
+    // keep the number of visited nodes per case roughly constant
+    int height = book.getHeight();
+    std::vector<int> sample = sampleIndices(names, std::max(2000, 4000000 / height), rng);
+
+    int found = 0;
+    std::size_t allocations_before = allocation_count;
+    Clock::time_point start = Clock::now();
+    for (int index : sample) {
+        found += book.findRecipe(names[index]) != nullptr;
+    }
+    double ns = nanosSince(start) / sample.size();
+    double allocs = double(allocation_count - allocations_before) / sample.size();
+
+    if (found != static_cast<int>(sample.size())) {
+        std::fprintf(stderr, "lookup missed %zu names\n", sample.size() - found);
+    }
+    printRow("lookup", "RecipeBook", shape, names.size(), height, ns, bytes_per_node, allocs);
+
+    // answered from the difficulty index in one descent
+    sample = sampleIndices(names, 200000, rng);
+    allocations_before = allocation_count;
+    start = Clock::now();
+    for (int index : sample) {
+        book.calculateMasteryPoints(names[index]);
+    }
+    ns = nanosSince(start) / sample.size();
+    allocs = double(allocation_count - allocations_before) / sample.size();
+    printRow("mastery_points", "RecipeBook", shape, names.size(), height, ns, bytes_per_node, allocs);
+
+    // the whole report in one pass, streamed into a checksum
+    long long total_points = 0;
+    allocations_before = allocation_count;
+    start = Clock::now();
+    book.calculateAllMasteryPoints([&total_points](const std::string&, int points) {
+        total_points += points;
+    });
+    ns = nanosSince(start) / names.size();
+    allocs = double(allocation_count - allocations_before) / names.size();
+    if (total_points < 0) {
+        std::fprintf(stderr, "mastery report overflowed\n");
+    }
+    printRow("mastery_report", "RecipeBook", shape, names.size(), height, ns, bytes_per_node, allocs);
+
+    // same names against the Eytzinger snapshot
+    bytes_before = live_bytes;
+    FrozenRecipeBook frozen(book);
+    bytes_per_node = double(live_bytes - bytes_before) / names.size();
+    sample = sampleIndices(names, std::max(2000, 4000000 / height), rng);
+    found = 0;
+    allocations_before = allocation_count;
+    start = Clock::now();
+    for (int index : sample) {
+        found += frozen.findRecipe(names[index]) != nullptr;
+    }
+    ns = nanosSince(start) / sample.size();
+    allocs = double(allocation_count - allocations_before) / sample.size();
+    if (found != static_cast<int>(sample.size())) {
+        std::fprintf(stderr, "frozen lookup missed %zu names\n", sample.size() - found);
+    }
+    printRow("frozen_lookup", "FrozenRecipeBook", shape, names.size(), height, ns, bytes_per_node, allocs);
+}
+
+/**
+* Builds Tree from insert_order, then times add and name lookups.
+*/
+template <class Tree>
+void nodeStoreCase(const char* container, const std::vector<std::string>& names, const std::vector<std::string>& insert_order, std::mt19937& rng) {
+    std::size_t bytes_before = live_bytes;
+    std::size_t allocations_before = allocation_count;
+    Tree tree;
+    Clock::time_point start = Clock::now();
+    for (const std::string& name : insert_order) {
+        tree.add(Recipe(name, 1, DESCRIPTION));
+    }
+    double add_ns = nanosSince(start) / names.size();
+    double add_allocs = double(allocation_count - allocations_before) / names.size();
+    double bytes_per_node = double(live_bytes - bytes_before) / names.size();
+
+    std::vector<int> sample = sampleIndices(names, 1000000, rng);
+    int found = 0;
+    allocations_before = allocation_count;
+    start = Clock::now();
+    for (int index : sample) {
+        found += tree.find(std::string_view(names[index])) != nullptr;
+    }
+    double find_ns = nanosSince(start) / sample.size();
+    double find_allocs = double(allocation_count - allocations_before) / sample.size();
+
+    if (found != static_cast<int>(sample.size())) {
+        std::fprintf(stderr, "%s missed %zu names\n", container, sample.size() - found);
+    }
+    printRow("node_store_add", container, "random", names.size(), tree.getHeight(), add_ns, bytes_per_node, add_allocs);
+    printRow("node_store_find", container, "random", names.size(), tree.getHeight(), find_ns, bytes_per_node, find_allocs);
+}
+
+/**
+* Times building a tree from sorted recipes, then cloning it.
+*/
+void bulkCase(const std::vector<std::string>& names) {
+    std::vector<Recipe> recipes;
+    recipes.reserve(names.size());
+    for (const std::string& name : names) {
+        recipes.emplace_back(name, 1, DESCRIPTION);
+    }
+
+    BinarySearchTree<Recipe, AvlBalance> tree;
+    Clock::time_point start = Clock::now();
+    tree.buildFromSorted(recipes.begin(), recipes.end());
+    double ns = nanosSince(start) / names.size();
+    printRow("bulk_build", "shared_ptr", "sorted", names.size(), tree.getHeight(), ns, 0, 0);
+
+    start = Clock::now();
+    BinarySearchTree<Recipe, AvlBalance> copy(tree);
+    ns = nanosSince(start) / names.size();
+    printRow("copy", "shared_ptr", "sorted", names.size(), copy.getHeight(), ns, 0, 0);
+}
+
+/**
+* Times rendering a book of names.size() recipes in each format.
+*/
+void renderCase(const std::vector<std::string>& names) {
+    std::vector<Recipe> recipes;
+    recipes.reserve(names.size());
+    for (std::size_t i = 0; i < names.size(); i++) {
+        recipes.emplace_back(names[i], i % 10, DESCRIPTION, i % 3 == 0);
+    }
+    RecipeBook book;
+    book.addRecipes(std::move(recipes));
+
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0) {
+        std::fprintf(stderr, "could not open /dev/null\n");
+        return;
+    }
+    const std::pair<const char*, RecipeWriter::Format> formats[] = {
+        {"text", RecipeWriter::Format::TEXT},
+        {"tsv", RecipeWriter::Format::TSV},
+        {"jsonl", RecipeWriter::Format::JSON_LINES},
+    };
+    for (const auto& format : formats) {
+        std::size_t allocations_before = allocation_count;
+        Clock::time_point start = Clock::now();
+        RecipeWriter writer(null_fd, format.second);
+        book.renderPreorder(writer);
+        writer.flush();
+        double ns = nanosSince(start) / names.size();
+        double allocs = double(allocation_count - allocations_before) / names.size();
+        printRow("render", "RecipeWriter", format.first, names.size(), book.getHeight(), ns, double(writer.size()) / names.size(), allocs);
+    }
+    close(null_fd);
+}
+
+/**
+* Indexes count descriptions of eight words each, drawn from a skewed
+vocabulary so a few words are in most descriptions, then times two-word queries.
+*/
+void textSearchCase(int count, std::mt19937& rng) {
+    const int vocabulary_size = 20000;
+    std::vector<std::string> vocabulary;
+    for (int i = 0; i < vocabulary_size; i++) {
+        vocabulary.push_back("word" + std::to_string(i));
+    }
+    // word i is drawn with weight 1 / (i + 1)
+    std::vector<double> weights;
+    for (int i = 0; i < vocabulary_size; i++) {
+        weights.push_back(1.0 / (i + 1));
+    }
+    std::discrete_distribution<int> pick_word(weights.begin(), weights.end());
+
+    std::vector<std::string> names = makeNames(count);
+    std::size_t bytes_before = live_bytes;
+    TextIndex index;
+    std::string description;
+    for (const std::string& name : names) {
+        description.clear();
+        for (int j = 0; j < 8; j++) {
+            description += vocabulary[pick_word(rng)];
+            description += ' ';
+        }
+        index.addDocument(name, description);
+    }
+    double bytes_per_node = double(live_bytes - bytes_before) / count;
+
+    std::uniform_int_distribution<int> any_word(0, vocabulary_size - 1);
+    const int queries = 2000;
+    std::vector<std::string> query_text;
+    for (int i = 0; i < queries; i++) {
+        query_text.push_back(vocabulary[pick_word(rng)] + " " + vocabulary[any_word(rng)]);
+    }
+
+    // OR returns most of the book whenever a common word is asked for, so
+    // its time is mostly spent merging posting lists; ids are returned, no
+    // name is copied
+    std::size_t matches = 0;
+    std::size_t allocations_before = allocation_count;
+    Clock::time_point start = Clock::now();
+    for (const std::string& query : query_text) {
+        matches += index.findAll(query).size();
+    }
+    double ns = nanosSince(start) / queries;
+    double allocs = double(allocation_count - allocations_before) / queries;
+    printRow("text_search_and", "TextIndex", "zipf", count, 0, ns, bytes_per_node, allocs);
+
+    allocations_before = allocation_count;
+    start = Clock::now();
+    for (const std::string& query : query_text) {
+        matches += index.findAny(query).size();
+    }
+    ns = nanosSince(start) / queries;
+    allocs = double(allocation_count - allocations_before) / queries;
+    printRow("text_search_or", "TextIndex", "zipf", count, 0, ns, bytes_per_node, allocs);
+    if (matches == 0) {
+        std::fprintf(stderr, "text search found nothing\n");
+    }
+}
+
+/**
+* Writes recipes to a CSV file in the format RecipeBook loads.
+* @return: False if the file could not be written.
+*/
+bool writeCsv(const char* csv_name, const std::vector<std::string>& order) {
+    std::FILE* csv_file = std::fopen(csv_name, "w");
+    if (csv_file == nullptr) {
+        std::fprintf(stderr, "could not write %s\n", csv_name);
+        return false;
+    }
+    std::fprintf(csv_file, "name,difficulty_level,description,mastered\n");
+    for (std::size_t i = 0; i < order.size(); i++) {
+        std::fprintf(csv_file, "%s,%zu,%s,%d\n", order[i].c_str(), i % 10, DESCRIPTION, i % 3 == 0 ? 1 : 0);
+    }
+    std::fclose(csv_file);
+    return true;
+}
+
+/**
+* Times loading a CSV export of count rows into an empty RecipeBook, the
+plain load that leaves every index to be built on first use, and reports it
+if the whole load goes over its budget.
+*/
+void csvLoadCase(int count, std::mt19937& rng) {
+    const char* const csv_name = "bench_recipes.csv";
+    const double budget_ms = 1000;
+    std::vector<std::string> order = makeNames(count);
+    std::shuffle(order.begin(), order.end(), rng);
+    if (!writeCsv(csv_name, order)) {
+        return;
+    }
+
+    std::size_t allocations_before = allocation_count;
+    Clock::time_point start = Clock::now();
+    RecipeBook book(csv_name);
+    double total_ns = nanosSince(start);
+    double allocs = double(allocation_count - allocations_before) / count;
+    printRow("csv_load", "RecipeBook", "random", count, book.getHeight(), total_ns / count, 0, allocs);
+    if (book.getNumberOfNodes() != count) {
+        std::fprintf(stderr, "csv load kept %d of %d rows\n", book.getNumberOfNodes(), count);
+    }
+    if (total_ns / 1e6 > budget_ms) {
+        std::fprintf(stderr, "csv load of %d rows took %.0f ms, over its %.0f ms budget\n", count, total_ns / 1e6, budget_ms);
+    }
+    std::remove(csv_name);
+}
+
+/**
+* Writes count recipes to a CSV file, then times RecipeBook::loadRecipes on it
+against RecipeBook::loadSnapshot on a snapshot of the loaded book.
+*/
+void snapshotCase(int count, std::mt19937& rng) {
+    const char* const csv_name = "bench_recipes.csv";
+    const char* const snapshot_name = "bench_recipes.snap";
+    std::vector<std::string> names = makeNames(count);
+    std::vector<std::string> order = names;
+    std::shuffle(order.begin(), order.end(), rng);
+    if (!writeCsv(csv_name, order)) {
+        return;
+    }
+
+    std::size_t allocations_before = allocation_count;
+    Clock::time_point start = Clock::now();
+    RecipeBook book(csv_name);
+    double ns = nanosSince(start) / count;
+    double allocs = double(allocation_count - allocations_before) / count;
+    printRow("snapshot_load", "csv", "random", count, book.getHeight(), ns, 0, allocs);
+
+    RecipeSnapshot::write(book, snapshot_name);
+    allocations_before = allocation_count;
+    start = Clock::now();
+    RecipeBook loaded;
+    bool loaded_ok = loaded.loadSnapshot(snapshot_name);
+    ns = nanosSince(start) / count;
+    allocs = double(allocation_count - allocations_before) / count;
+    if (!loaded_ok || loaded.getNumberOfNodes() != book.getNumberOfNodes()
+        || loaded.calculateAllMasteryPoints() != book.calculateAllMasteryPoints()) {
+        std::fprintf(stderr, "snapshot did not round-trip\n");
+    }
+    printRow("snapshot_load", "snapshot", "random", count, loaded.getHeight(), ns, 0, allocs);
+
+    RecipeSnapshot snapshot;
+    allocations_before = allocation_count;
+    start = Clock::now();
+    bool opened = snapshot.open(snapshot_name);
+    ns = nanosSince(start) / count;
+    allocs = double(allocation_count - allocations_before) / count;
+    if (!opened) {
+        std::fprintf(stderr, "could not open %s\n", snapshot_name);
+    }
+    printRow("snapshot_open", "RecipeSnapshot", "random", count, 0, ns, 0, allocs);
+
+    std::vector<int> sample = sampleIndices(names, 1000000, rng);
+    int found = 0;
+    allocations_before = allocation_count;
+    start = Clock::now();
+    for (int index : sample) {
+        found += snapshot.find(names[index]).has_value();
+    }
+    ns = nanosSince(start) / sample.size();
+    allocs = double(allocation_count - allocations_before) / sample.size();
+    if (found != static_cast<int>(sample.size())) {
+        std::fprintf(stderr, "snapshot lookup missed %zu names\n", sample.size() - found);
+    }
+    printRow("snapshot_find", "RecipeSnapshot", "random", count, 0, ns, 0, allocs);
+
+    snapshot.close();
+    std::remove(csv_name);
+    std::remove(snapshot_name);
+}
+
+/**
+* A synthetic book for the suite.
+*/
+struct Workload
+{
+    std::vector<Recipe> recipes;   // in insertion order
+    std::vector<std::string> queries; // names to look up, all present
+};
+
+/**
+* Generates count recipes. shape picks the insertion order of the names, and
+the names that lookups ask for:
+*   random: shuffled, queries uniform over the book;
+*   sorted / reverse: ascending / descending, queries uniform;
+*   zipf: shuffled, queries drawn with weight 1 / (rank + 1), so a few
+popular recipes take most lookups. Ranks are scattered over the tree.
+* Descriptions are two words from a small vocabulary, so the CSV of a 10M
+book stays a few hundred MB.
+*/
+Workload makeWorkload(const std::string& shape, int count, int query_count, std::mt19937& rng) {
+    static const char* const WORDS[] = {"braised", "roasted", "chilled", "spiced", "smoked", "glazed", "pickled", "seared"};
+    const int word_count = sizeof(WORDS) / sizeof(WORDS[0]);
+
+    std::vector<std::string> names = makeNames(count);
+    Workload workload;
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++) {
+        order[i] = shape == "reverse" ? count - 1 - i : i;
+    }
+    if (shape == "random" || shape == "zipf") {
+        std::shuffle(order.begin(), order.end(), rng);
+    }
+    workload.recipes.reserve(count);
+    for (int index : order) {
+        std::string description = std::string(WORDS[index % word_count]) + " " + WORDS[(index / word_count) % word_count];
+        workload.recipes.emplace_back(names[index], index % 10, std::move(description), index % 3 == 0);
+    }
+
+    workload.queries.reserve(query_count);
+    std::uniform_int_distribution<int> uniform(0, count - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (int i = 0; i < query_count; i++) {
+        int index;
+        if (shape == "zipf") {
+            // inverse CDF of the continuous 1/x law, the s = 1 Zipf limit
+            long long rank = static_cast<long long>(std::exp(unit(rng) * std::log(count + 1.0))) - 1;
+            rank = std::min<long long>(std::max<long long>(rank, 0), count - 1);
+            index = static_cast<int>((rank * 2654435761LL) % count);
+        } else {
+            index = uniform(rng);
+        }
+        workload.queries.push_back(names[index]);
+    }
+    return workload;
+}
+
+/**
+* Times every RecipeBook operation on one workload.
+* Book is RecipeBook or BTreeRecipeBook, named container in the rows.
+*/
+template <class Book>
+void suiteCase(const char* container, const std::string& shape, int count, std::mt19937& rng) {
+    const int query_count = std::min(count, 200000);
+    Workload workload = makeWorkload(shape, count, query_count, rng);
+    const char* const shape_name = shape.c_str();
+    const char* const csv_name = "bench_suite.csv";
+
+    auto report = [&](const char* benchmark, int height, Clock::time_point start, std::size_t operations, std::size_t allocations_before, double bytes_per_node) {
+        double ns = nanosSince(start) / operations;
+        double allocs = double(allocation_count - allocations_before) / operations;
+        printRow(benchmark, container, shape_name, count, height, ns, bytes_per_node, allocs);
+    };
+
+    // load: parse a CSV written in insertion order, then bulk build
+    std::FILE* csv_file = std::fopen(csv_name, "w");
+    if (csv_file == nullptr) {
+        std::fprintf(stderr, "could not write %s\n", csv_name);
+        return;
+    }
+    std::fprintf(csv_file, "name,difficulty_level,description,mastered\n");
+    for (const Recipe& recipe : workload.recipes) {
+        std::fprintf(csv_file, "%s,%d,%s,%d\n", recipe.name_.c_str(), recipe.difficulty_level_, recipe.description_.c_str(), recipe.mastered_ ? 1 : 0);
+    }
+    std::fclose(csv_file);
+    std::size_t bytes_before = live_bytes;
+    std::size_t allocations_before = allocation_count;
+    Clock::time_point start = Clock::now();
+    Book* loaded = new Book(csv_name);
+    report("suite_load", loaded->getHeight(), start, count, allocations_before, double(live_bytes - bytes_before) / count);
+    std::remove(csv_name);
+    delete loaded;
+
+    // add: one addRecipe per recipe, in insertion order
+    bytes_before = live_bytes;
+    allocations_before = allocation_count;
+    start = Clock::now();
+    Book book;
+    // built while empty, so every add below also pays for its index entries
+    buildIndexes(book);
+    for (const Recipe& recipe : workload.recipes) {
+        book.addRecipe(recipe);
+    }
+    double bytes_per_node = double(live_bytes - bytes_before) / count;
+    report("suite_add", book.getHeight(), start, count, allocations_before, bytes_per_node);
+
+    int found = 0;
+    allocations_before = allocation_count;
+    start = Clock::now();
+    for (const std::string& name : workload.queries) {
+        found += book.findRecipe(name) != nullptr;
+    }
+    report("suite_find", book.getHeight(), start, workload.queries.size(), allocations_before, bytes_per_node);
+    if (found != query_count) {
+        std::fprintf(stderr, "suite find missed %d names\n", query_count - found);
+    }
+
+    allocations_before = allocation_count;
+    start = Clock::now();
+    long long total_points = 0;
+    for (const std::string& name : workload.queries) {
+        total_points += book.calculateMasteryPoints(name);
+    }
+    report("suite_mastery_points", book.getHeight(), start, workload.queries.size(), allocations_before, bytes_per_node);
+    if (total_points < 0) {
+        std::fprintf(stderr, "suite mastery points overflowed\n");
+    }
+
+    // churn: remove a recipe and add it back, per pair
+    const int churn_count = std::min(count, 50000);
+    allocations_before = allocation_count;
+    start = Clock::now();
+    for (int i = 0; i < churn_count; i++) {
+        const Recipe& recipe = workload.recipes[i];
+        book.removeRecipe(recipe.name_);
+        book.addRecipe(recipe);
+    }
+    report("suite_remove_add", book.getHeight(), start, churn_count, allocations_before, bytes_per_node);
+
+    allocations_before = allocation_count;
+    start = Clock::now();
+    book.balance();
+    report("suite_balance", book.getHeight(), start, count, allocations_before, bytes_per_node);
+
+    allocations_before = allocation_count;
+    start = Clock::now();
+    Book* copy = new Book(book);
+    report("suite_copy", copy->getHeight(), start, count, allocations_before, bytes_per_node);
+    delete copy;
+}
+
+/**
+* Times RecipeBook's published versions: reader threads look names up in the
+latest version while this thread removes, re-adds and re-masters Recipes.
+* Only the odd Recipes are removed and added back, one at a time, so every
+version must hold every even name and count or count - 1 Recipes.
+*/
+void publishedCase(int count, std::mt19937& rng) {
+    const int reader_count = 3;
+    const int churn_count = std::min(count / 2, 50000);
+    std::vector<std::string> names = makeNames(count);
+    std::vector<Recipe> recipes;
+    recipes.reserve(count);
+    for (int i = 0; i < count; i++) {
+        recipes.emplace_back(names[i], i % 10, DESCRIPTION, i % 3 == 0);
+    }
+    std::shuffle(recipes.begin(), recipes.end(), rng);
+    RecipeBook book;
+    book.addRecipes(recipes);
+    buildIndexes(book);
+
+    std::size_t bytes_before = live_bytes;
+    std::size_t allocations_before = allocation_count;
+    Clock::time_point start = Clock::now();
+    book.setPublishing(true);
+    double bytes_per_node = double(live_bytes - bytes_before) / count;
+    printRow("published_start", "RecipeBook", "random", count, book.getHeight(), nanosSince(start) / count, bytes_per_node, double(allocation_count - allocations_before) / count);
+
+    // shape is "idle" with no reader running, "readers" with reader_count of them
+    std::uniform_int_distribution<int> pick_odd(0, count / 2 - 1);
+    std::uniform_int_distribution<int> pick_even(0, (count - 1) / 2);
+    auto writeChurn = [&](const char* shape) {
+        std::size_t allocations_before = allocation_count;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < churn_count; i++) {
+            const Recipe* recipe = book.findRecipe(names[2 * pick_odd(rng) + 1]);
+            Recipe removed = *recipe;
+            book.removeRecipe(removed.name_);
+            book.addRecipe(std::move(removed));
+        }
+        printRow("published_remove_add", "RecipeBook", shape, count, book.getHeight(), nanosSince(start) / churn_count, bytes_per_node, double(allocation_count - allocations_before) / churn_count);
+
+        allocations_before = allocation_count;
+        start = Clock::now();
+        for (int i = 0; i < churn_count; i++) {
+            const std::string& name = names[2 * pick_even(rng)];
+            book.setMastered(name, !book.findRecipe(name)->mastered_);
+        }
+        printRow("published_set_mastered", "RecipeBook", shape, count, book.getHeight(), nanosSince(start) / churn_count, bytes_per_node, double(allocation_count - allocations_before) / churn_count);
+    };
+    writeChurn("idle");
+
+    std::atomic<bool> writing(true);
+    std::atomic<long long> lookups(0);
+    std::atomic<long long> errors(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < reader_count; r++) {
+        readers.emplace_back([&, r]() {
+            std::mt19937 reader_rng(r);
+            std::uniform_int_distribution<int> reader_pick(0, (count - 1) / 2);
+            long long done = 0;
+            long long wrong = 0;
+            // one more round after the writer stops, so every reader runs at least once
+            bool last_round = false;
+            while (!last_round) {
+                last_round = !writing;
+                PublishedRecipes published = book.publishedRecipes();
+                int size = published.getNumberOfNodes();
+                wrong += size != count && size != count - 1;
+                for (int i = 0; i < 64; i++) {
+                    const std::string& name = names[2 * reader_pick(reader_rng)];
+                    const Recipe* recipe = published.findRecipe(name);
+                    wrong += recipe == nullptr || recipe->name_ != name;
+                }
+                done += 64;
+            }
+            lookups += done;
+            errors += wrong;
+        });
+    }
+
+    Clock::time_point readers_start = Clock::now();
+    writeChurn("readers");
+
+    writing = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    printRow("published_find", "RecipeBook", "readers", count, book.getHeight(), nanosSince(readers_start) / lookups, bytes_per_node, 0);
+    if (errors != 0) {
+        std::fprintf(stderr, "published versions failed %lld checks\n", static_cast<long long>(errors));
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long long max_n = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    std::mt19937 rng(235);
+    std::printf("benchmark,container,shape,n,height,ns_per_op,bytes_per_node,allocs_per_op\n");
+
+    for (int n = 1000; n <= 256000; n *= 4) {
+        std::vector<std::string> names = makeNames(n);
+        std::vector<std::string> order = names;
+        std::shuffle(order.begin(), order.end(), rng);
+        lookupCase("random", names, order, rng);
+        // sorted input used to degenerate into a list of height n,
+        // the AVL base keeps it at O(log n)
+        lookupCase("sorted", names, names, rng);
+    }
+
+    publishedCase(100000, rng);
+    // the load a 500k-row export has to finish well under a second
+    csvLoadCase(500000, rng);
+
+    // the fixed 1M cases are skipped by quick runs with a smaller max_n
+    if (max_n >= 1000000) {
+        textSearchCase(1000000, rng);
+        snapshotCase(1000000, rng);
+
+        std::vector<std::string> names = makeNames(1000000);
+        std::vector<std::string> order = names;
+        std::shuffle(order.begin(), order.end(), rng);
+        nodeStoreCase<BinarySearchTree<Recipe, AvlBalance>>("shared_ptr", names, order, rng);
+        nodeStoreCase<ArenaBinarySearchTree<Recipe>>("arena", names, order, rng);
+        nodeStoreCase<BTree<Recipe>>("btree", names, order, rng);
+        nodeStoreCase<BTree<Recipe, 32>>("btree_t32", names, order, rng);
+        bulkCase(names);
+        renderCase(names);
+    }
+
+    const char* const shapes[] = {"random", "sorted", "reverse", "zipf"};
+    for (long long n = 1000; n <= max_n && n <= 10000000; n *= 10) {
+        for (const char* shape : shapes) {
+            suiteCase<RecipeBook>("RecipeBook", shape, static_cast<int>(n), rng);
+            suiteCase<BTreeRecipeBook>("BTreeRecipeBook", shape, static_cast<int>(n), rng);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+/**
+*@file csv2snapshot.cpp
+* Converts a recipe CSV file into a binary RecipeBook snapshot.
+* Usage: csv2snapshot input.csv output.snap
+*/
+
+#include <iostream>
+#include "RecipeBook.hpp"
+#include "RecipeSnapshot.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " input.csv output.snap" << std::endl;
+        return 2;
+    }
+
+    RecipeBook book;
+    std::vector<std::string> duplicate_names = book.loadRecipes(argv[1]);
+    for (const std::string& name : duplicate_names) {
+        std::cerr << "skipped duplicate recipe: " << name << std::endl;
+    }
+
+    if (!RecipeSnapshot::write(book, argv[2])) {
+        std::cerr << "could not write " << argv[2] << std::endl;
+        return 1;
+    }
+    std::cout << book.getNumberOfNodes() << " recipes written to " << argv[2] << std::endl;
+    return 0;
+}
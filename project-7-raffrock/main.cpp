@@ -47,15 +47,14 @@ int main() {
 
     std::cout << "root: " << onlyName5.getRoot()->getItem().name_ << std::endl;
 
-    std::cout << "findRecipe: name2 -> " << myRecipeBook.findRecipe("name2")->getItem().name_ << std::endl;
+    std::cout << "findRecipe: name2 -> " << myRecipeBook.findRecipe("name2")->name_ << std::endl;
     std::cout << "addRecipe: " << myRecipeBook.addRecipe(name5) << std::endl;  // 0
     std::cout << "removeRecipe: " << myRecipeBook.removeRecipe("name6") << std::endl; // 1
     onlyName5.clear(); //works
     std::cout << "calculateMasteryPoints: " << myRecipeBook.calculateMasteryPoints("name2") << std::endl; // 1+2+3+4 = 10
     // std::cout << "before height: " << myRecipeBook.getHeight();
     myRecipeBook.balance();
-    // std::cout << "  after heigh
-    t: " << myRecipeBook.getHeight() << std::endl;
+    // std::cout << "  after height: " << myRecipeBook.getHeight() << std::endl;
     //  std::cout << "  left height: " << myRecipeBook.get() << "  right height: " << myRecipeBook.getHeight() << std::endl;
     std::cout << "\nonlyName5 display\n\n";
     onlyName5.preorderDisplay();